@@ -65,6 +65,57 @@
 // 20230420 Added pin config for
 //          DFRobot FireBeetle ESP32 + FireBeetle Cover LoRa
 // 20231009 Renamed FIREBEETLE_COVER_LORA in FIREBEETLE_ESP32_COVER_LORA
+// 20261016 Modbus data acquisition is done by a non-blocking state machine
+//          stepped from cSensor::loop()
+//          Optionally, Modbus data is acquired in a separate task (ACQ_TASK)
+//          and uplinks are encoded from the latest snapshot
+//          Added compact payload format (see PAYLOAD_VERSION in settings.h)
+//          Data of all due ports is merged into one uplink if the current
+//          data rate allows it
+//          Added execution time measurement (ENABLE_TIMING)
+//          Added runtime statistics and CMD_GET_STATS
+//          Implemented deep sleep duty cycle (SLEEP_EN) with last good
+//          Modbus data kept in RTC RAM; Modbus is skipped while the
+//          inverter is offline
+//          Added support for multiple inverters on one RS485 bus
+//          (MODBUS_SLAVES in settings.h; summary uplink on port 8)
+//          Added store-and-forward of readings which could not be sent
+//          (RINGLOG_EN in settings.h; backfill uplink on port 9)
+//          Added min/max/mean and energy aggregated between uplinks
+//          (PAYLOAD_AGG in settings.h)
+//          Added report by exception - uplinks of unchanged data are
+//          suppressed (RBE_EN in settings.h; CMD_SET_DEADBAND, CMD_SET_HEARTBEAT)
+//          Data is sent unconfirmed except for periodic link checks and
+//          while the link quality is low (CMD_SET_UPLINK_POLICY)
+//          Replaced if-chain in ReceiveCb() by table-driven command dispatcher;
+//          multiple commands can be sent in one downlink
+//          Preferences are saved as one blob (single NVS commit)
+//          Fixed preferences namespace/key in CMD_SET_SLEEP_INTERVAL[_LONG]
+//          Implemented CMD_GET_INVERTER_SETTINGS - answered from cached
+//          holding registers (refreshed in the background, see settingsCache.h)
+//          Added remote power limitation (CMD_SET_POWER_LIMIT, see powerLimit.h)
+//          Moved pin mappings to board profiles (src/boards.h); Modbus
+//          interface is selected once and initialized with the first
+//          acquisition (persistent link session, see src/modbusSession.h)
+//          Added inverter state aware uplink scheduler - uplinks are
+//          stretched while the inverter is idle and sent immediately on
+//          fault/warning changes (CMD_SET_SCHEDULE, see src/uplinkScheduler.h)
+//          Added fault/warning event uplink - changes of faultbitcode and
+//          warningbitcode are sent ahead of the periodic uplinks
+//          (port 10, see src/faultEvents.h)
+//          Added triggered capture of grid frequency/voltage disturbances
+//          (CAPTURE_EN, port 11, see src/gridCapture.h)
+//          Moved rtStats to src/stats.cpp (firmware modules are built
+//          and tested on the host, see host/)
+//          CMD_GET_STATS: counters are sent as uint24 (uint32 counters)
+//          Pending response uplinks are kept in a bitmap - all GET commands
+//          of a downlink are answered
+//          Default Modbus interface is RS485 (MODBUS_IF in settings.h)
+//          Fixed CMD_GET_CONFIG response byte map (10 bytes, no reserved byte)
+//          Removed no-op rbe_ack() call if an uplink could not be queued
+//          Unconfirmed uplinks keep the delta reference (PAYLOAD_DELTA);
+//          their readings are held until a confirmed uplink covers them
+//          and are logged if it fails (RINGLOG_EN)
 //
 // Notes:
 // - After a successful transmission, the controller can go into deep sleep
@@ -103,6 +154,17 @@
 #include <Preferences.h>
 #include "src/settings.h"
 #include "src/payload.h"
+#include "src/acquisition.h"
+#include "src/stats.h"
+#include "src/ringlog.h"
+#include "src/rbe.h"
+#include "src/uplinkPolicy.h"
+#include "src/downlink.h"
+#include "src/settingsCache.h"
+#include "src/powerLimit.h"
+#include "src/uplinkScheduler.h"
+#include "src/faultEvents.h"
+#include "src/gridCapture.h"
 
 // NOTE: Add #define LMIC_ENABLE_DeviceTimeReq 1
 //        in ~/Arduino/libraries/MCCI_LoRaWAN_LMIC_library/project_config/lmic_project_config.h
@@ -154,6 +216,29 @@ const Schedule UplinkSchedule[NUM_PORTS] = {
 // Long sleep interval, MCU will sleep for SLEEP_INTERVAL_LONG seconds if battery voltage is below BATTERY_WEAK
 #define SLEEP_INTERVAL_LONG 900
 
+// If SLEEP_EN is defined and the inverter did not respond (offline at night),
+// Modbus is only accessed every OFFLINE_RETRY wake-ups
+#define OFFLINE_RETRY 5
+
+#if defined(SLEEP_EN)
+    // Modbus data is acquired once per wake-up, not by the acquisition task
+    #undef ACQ_TASK
+    // no samples between wake-ups - nothing to aggregate
+    #undef PAYLOAD_AGG
+#endif
+
+#if defined(CAPTURE_EN) && defined(SLEEP_EN)
+    #error "CAPTURE_EN requires continuous operation - undefine SLEEP_EN"
+#endif
+
+#if defined(RINGLOG_EN) && (PAYLOAD_VERSION != 2)
+    #error "RINGLOG_EN requires PAYLOAD_VERSION 2"
+#endif
+
+#if defined(PAYLOAD_AGG) && (PAYLOAD_VERSION != 2)
+    #error "PAYLOAD_AGG requires PAYLOAD_VERSION 2"
+#endif
+
 // Force deep sleep after a certain time, even if transmission was not completed
 //#define FORCE_SLEEP
 
@@ -175,98 +260,7 @@ const Schedule UplinkSchedule[NUM_PORTS] = {
 // LoRa_Serialization
 #include <LoraMessage.h>
 
-// Pin mappings for some common ESP32 LoRaWAN boards.
-// The ARDUINO_* defines are set by selecting the appropriate board (and borad variant, if applicable) in the Arduino IDE.
-// The default SPI port of the specific board will be used.
-#if defined(ARDUINO_TTGO_LoRa32_V1)
-    // https://github.com/espressif/arduino-esp32/blob/master/variants/ttgo-lora32-v1/pins_arduino.h
-    // http://www.lilygo.cn/prod_view.aspx?TypeId=50003&Id=1130&FId=t3:50003:3
-    // https://github.com/Xinyuan-LilyGo/TTGO-LoRa-Series
-    // https://github.com/LilyGO/TTGO-LORA32/blob/master/schematic1in6.pdf
-    #define PIN_LMIC_NSS      LORA_CS
-    #define PIN_LMIC_RST      LORA_RST
-    #define PIN_LMIC_DIO0     LORA_IRQ
-    #define PIN_LMIC_DIO1     33
-    #define PIN_LMIC_DIO2     cMyLoRaWAN::lmic_pinmap::LMIC_UNUSED_PIN
-
-#elif defined(ARDUINO_TTGO_LoRa32_V2)
-    // https://github.com/espressif/arduino-esp32/blob/master/variants/ttgo-lora32-v2/pins_arduino.h
-    #define PIN_LMIC_NSS      LORA_CS
-    #define PIN_LMIC_RST      LORA_RST
-    #define PIN_LMIC_DIO0     LORA_IRQ
-    #define PIN_LMIC_DIO1     33
-    #define PIN_LMIC_DIO2     cMyLoRaWAN::lmic_pinmap::LMIC_UNUSED_PIN
-    #pragma message("LoRa DIO1 must be wired to GPIO33 manually!")
-
-#elif defined(ARDUINO_TTGO_LoRa32_v21new)
-    // https://github.com/espressif/arduino-esp32/blob/master/variants/ttgo-lora32-v21new/pins_arduino.h
-    #define PIN_LMIC_NSS      LORA_CS
-    #define PIN_LMIC_RST      LORA_RST
-    #define PIN_LMIC_DIO0     LORA_IRQ
-    #define PIN_LMIC_DIO1     LORA_D1
-    #define PIN_LMIC_DIO2     LORA_D2
-
-#elif defined(ARDUINO_heltec_wireless_stick) || defined(ARDUINO_heltec_wifi_lora_32_V2)
-    // https://github.com/espressif/arduino-esp32/blob/master/variants/heltec_wireless_stick/pins_arduino.h
-    // https://github.com/espressif/arduino-esp32/tree/master/variants/heltec_wifi_lora_32_V2/pins_ardiono.h
-    #define PIN_LMIC_NSS      SS
-    #define PIN_LMIC_RST      RST_LoRa
-    #define PIN_LMIC_DIO0     DIO0
-    #define PIN_LMIC_DIO1     DIO1
-    #define PIN_LMIC_DIO2     DIO2
-
-#elif defined(ARDUINO_ADAFRUIT_FEATHER_ESP32S2)
-    #define PIN_LMIC_NSS      6
-    #define PIN_LMIC_RST      9
-    #define PIN_LMIC_DIO0     5
-    #define PIN_LMIC_DIO1     11
-    #define PIN_LMIC_DIO2     cMyLoRaWAN::lmic_pinmap::LMIC_UNUSED_PIN
-    #pragma message("ARDUINO_ADAFRUIT_FEATHER_ESP32S2 defined; assuming RFM95W FeatherWing will be used")
-    #pragma message("Required wiring: E to IRQ, D to CS, C to RST, A to DI01")
-    #pragma message("BLE is not available!")
-
-#elif defined(ARDUINO_FEATHER_ESP32)
-    #define PIN_LMIC_NSS      14
-    #define PIN_LMIC_RST      27
-    #define PIN_LMIC_DIO0     32
-    #define PIN_LMIC_DIO1     33
-    #define PIN_LMIC_DIO2     cMyLoRaWAN::lmic_pinmap::LMIC_UNUSED_PIN
-    #pragma message("NOT TESTED!!!")
-    #pragma message("ARDUINO_ADAFRUIT_FEATHER_ESP32 defined; assuming RFM95W FeatherWing will be used")
-    #pragma message("Required wiring: A to RST, B to DIO1, D to DIO0, E to CS")
-
-#elif defined(FIREBEETLE_ESP32_COVER_LORA)
-    // https://wiki.dfrobot.com/FireBeetle_ESP32_IOT_Microcontroller(V3.0)__Supports_Wi-Fi_&_Bluetooth__SKU__DFR0478
-    // https://wiki.dfrobot.com/FireBeetle_Covers_LoRa_Radio_868MHz_SKU_TEL0125
-    #define PIN_LMIC_NSS      27 // D4
-    #define PIN_LMIC_RST      25 // D2
-    #define PIN_LMIC_DIO0     26 // D3
-    #define PIN_LMIC_DIO1      9 // D5
-    #define PIN_LMIC_DIO2     cMyLoRaWAN::lmic_pinmap::LMIC_UNUSED_PIN
-    #pragma message("FIREBEETLE_ESP32_COVER_LORA defined; assuming FireBeetle ESP32 with FireBeetle Cover LoRa will be used")
-    #pragma message("Required wiring: D2 to RESET, D3 to DIO0, D4 to CS, D5 to DIO1")
-
-#elif defined(LORAWAN_NODE)
-    // LoRaWAN_Node board
-    // https://github.com/matthias-bs/LoRaWAN_Node
-    #pragma message("LORAWAN_NODE defined; assuming LoRaWAN_Node board will be used")
-    #define PIN_LMIC_NSS      14
-    #define PIN_LMIC_RST      12
-    #define PIN_LMIC_DIO0     4
-    #define PIN_LMIC_DIO1     16
-    #define PIN_LMIC_DIO2     17
-
-#else
-    #pragma message("Unknown board; please select one in the Arduino IDE or in settings.h or create your own!")
-    
-    // definitions for generic CI target ESP32:ESP32:ESP32
-    #define PIN_LMIC_NSS      14
-    #define PIN_LMIC_RST      12
-    #define PIN_LMIC_DIO0     4
-    #define PIN_LMIC_DIO1     16
-    #define PIN_LMIC_DIO2     17
-
-#endif
+// Pin mappings of the supported boards: see src/boards.h
 
 // Uplink message payload size
 // The maximum allowed for all data rates is 51 bytes.
@@ -289,6 +283,15 @@ const uint8_t PAYLOAD_SIZE = 51;
 // Downlink messages
 // ------------------
 //
+// A downlink may contain several commands back to back, e.g.
+// A8 01 2C AB 05 B1: set sleep interval to 300 s, set heartbeat to 5, get config
+// The downlink is ignored if it contains an unknown or truncated command.
+// Each GET command is answered by its own response uplink. Pending
+// responses are kept in a bitmap, i.e. several different GET commands
+// (e.g. B1 B2 C0) are answered one after another in the order
+// CMD_GET_DATETIME, CMD_GET_CONFIG, CMD_GET_STATS, CMD_GET_INVERTER_SETTINGS;
+// a command repeated before its response has been sent is answered once.
+//
 // CMD_SET_WEATHERSENSOR_TIMEOUT
 // (seconds)
 // byte0: 0xA0
@@ -322,6 +325,42 @@ const uint8_t PAYLOAD_SIZE = 51;
 // CMD_GET_INVERTER_SETTINGS
 // byte0: 0xC0
 //
+// CMD_GET_STATS
+// byte0: 0xB2
+//
+// CMD_SET_POWER_LIMIT
+// (max. output active power; the result is reported on FPort 6)
+// byte0: 0xC1
+// byte1: maxoutputactivepp[ 7:0] (0...100 %, 255: not limited)
+//
+// CMD_SET_DEADBAND
+// (report by exception, see rbe.h for field index and units)
+// byte0: 0xAA
+// byte1: field index
+// byte2: deadband[15:8]
+// byte3: deadband[ 7:0]
+//
+// CMD_SET_HEARTBEAT
+// (max. no. of consecutive suppressed uplinks; 0: report by exception disabled)
+// byte0: 0xAB
+// byte1: heartbeat[ 7:0]
+//
+// CMD_SET_UPLINK_POLICY
+// byte0: 0xAC
+// byte1: confirm_every[ 7:0] (send every <n>th uplink confirmed; 0: never, 1: always)
+// byte2: ack_rate_min[ 7:0]  (min. ACK rate in %)
+// byte3: margin_min[ 7:0]    (min. link margin in dB, signed)
+//
+// CMD_SET_SCHEDULE
+// (uplink interval while the inverter is offline/waiting or at night, see uplinkScheduler.h)
+// byte0: 0xAD
+// byte1: idle_interval[15:8] (minutes; 0: disabled)
+// byte2: idle_interval[ 7:0]
+// byte3: min_power[15:8]     (min. output power in production in W)
+// byte4: min_power[ 7:0]
+// byte5: night_start[ 7:0]   (start of night window, local hour 0...23)
+// byte6: night_end[ 7:0]     (end of night window, local hour 0...23; night_start: disabled)
+//
 // Response uplink messages
 // -------------------------
 //
@@ -333,21 +372,55 @@ const uint8_t PAYLOAD_SIZE = 51;
 // byte4: rtc_source[ 7: 0]
 //
 // CMD_GET_CONFIG -> FPort=4
-// byte0: reserved[ 7: 0]
-// byte1: sleep_interval[15: 8]
-// byte2: sleep_interval[ 7:0]
-// byte3: sleep_interval_long[15:8]
-// byte4: sleep_interval_long[ 7:0]
+// byte0: sleep_interval[15: 8]
+// byte1: sleep_interval[ 7:0]
+// byte2: sleep_interval_long[15:8]
+// byte3: sleep_interval_long[ 7:0]
+// byte4: idle_interval[15:8]
+// byte5: idle_interval[ 7:0]
+// byte6: min_power[15:8]
+// byte7: min_power[ 7:0]
+// byte8: night_start[ 7:0]
+// byte9: night_end[ 7:0]
 //
 // CMD_GET_INVERTER_SETTINGS -> FPort=5
-// TBD
+// byte0:      age of cached data in hours (0xFE: unknown, 0xFF: no data)
+// byte1..50:  holding registers (see settingsCache.cpp)
+//
+// CMD_SET_POWER_LIMIT -> FPort=6
+// byte0: result (0: success, 0xFE: read-back value differs, other: Modbus error)
+// byte1: requested value [%]
+// byte2: value read back [%]
+//
+// CMD_GET_STATS -> FPort=7
+// (little endian; counters: uint24 - low 24 bits of uint32 counters since
+// power-on, wrapping around; times: uint16 in ms)
+// byte0..2:   wake-ups
+// byte3..5:   Modbus requests
+// byte6..8:   Modbus requests with more blocks pending
+// byte9..11:  Modbus errors
+// byte12..14: Modbus timeouts
+// byte15..17: Modbus CRC errors
+// byte18..20: Modbus retries
+// byte21..23: acquisitions failed
+// byte24..26: uplinks
+// byte27..29: uplinks skipped (busy)
+// byte30..32: uplinks failed
+// byte33..38: acquisition time min/max/mean
+// byte39..44: wake time min/max/mean
 
 #define CMD_SET_SLEEP_INTERVAL          0xA8
 #define CMD_SET_SLEEP_INTERVAL_LONG     0xA9
+#define CMD_SET_DEADBAND                0xAA
+#define CMD_SET_HEARTBEAT               0xAB
+#define CMD_SET_UPLINK_POLICY           0xAC
+#define CMD_SET_SCHEDULE                0xAD
 #define CMD_GET_CONFIG                  0xB1
+#define CMD_GET_STATS                   0xB2
 #define CMD_GET_DATETIME                0x86
 #define CMD_SET_DATETIME                0x88
 #define CMD_GET_INVERTER_SETTINGS       0xC0
+#define CMD_SET_POWER_LIMIT             0xC1
 
 
 #if defined(GET_NETWORKTIME)
@@ -429,6 +502,7 @@ private:
     
 private:
     bool m_fBusy;                       // set true while sending an uplink
+    uint8_t m_uplinkReq = 0;            // uplink request being sent (see uplinkReq)
 
 protected:
     // you'll need to provide implementation for this.
@@ -469,10 +543,16 @@ public:
     uint16_t getVoltageBattery(void);
     uint16_t getVoltageSupply(void);
     bool     isUplinkPending(void) {
-        if (this->m_fBusy) {
+        if (this->m_fBusy || m_acq.isBusy()) {
             log_d("Busy");
             return true;          
         }   
+        #if defined(RINGLOG_EN)
+        if (m_fBackfillReq)
+            return true;
+        #endif
+        if (m_fEventReq)
+            return true;
         for (int idx=0; idx<NUM_PORTS; idx++) {
             log_d("m_fUplinkRequest[%d]=%d", idx, m_fUplinkRequest[idx]);
             if (m_fUplinkRequest[idx])
@@ -503,7 +583,7 @@ public:
     void loop();
 
     bool isBusy(void) {
-      return m_fBusy;
+      return m_fBusy || m_acq.isBusy();
     }
 
     // Example sensor status flags
@@ -516,13 +596,52 @@ public:
     uint16_t supply_voltage_v;  //<! supply voltage
     
 private:
-    void doUplink(int port);
+    void doUplink(uint8_t groups);
+    uint8_t selectGroups(uint8_t due);
+    #if defined(SLEEP_EN)
+    void updateCache(void);
+    #endif
+    #if defined(RINGLOG_EN)
+    void doBackfill(void);
+    void logSample(void);
+    #endif
+    void doEvents(void);
+    #if defined(CAPTURE_EN)
+    void doCapture(void);
+    #endif
 
+    ModbusAcquisition m_acq;                      //!< Modbus data acquisition
     bool m_fUplinkRequest[NUM_PORTS];             //!< set true when uplink is requested
     bool m_fBusy;                                 //!< set true while sending an uplink
     std::uint32_t m_uplinkPeriodMs;               //!< uplink period in milliseconds
     std::uint8_t const m_uplinkPeriodMult[NUM_PORTS] = UPLINK_PERIOD_MULTIPLIERS;  //!< uplink period multiplier per port 
     std::uint32_t m_tReference[NUM_PORTS];        //!< time of last uplink
+    std::uint8_t m_uplinkGroups;                  //!< data groups of uplink in progress
+    bool m_fConfirmed;                            //!< uplink in progress is confirmed
+    #if defined(RINGLOG_EN)
+    uint8_t m_sample[SAMPLE_SIZE];                //!< sample of uplink in progress
+    uint8_t m_sampleLen;                          //!< sample size (0: no valid data)
+    uint32_t m_sampleTime;                        //!< sample timestamp
+    bool m_fBackfillReq = false;                  //!< backfill uplink requested
+    uint32_t m_tBackfill = 0;                     //!< time of last successful backfill (0: link down)
+    #endif
+    #if defined(PAYLOAD_AGG) && !defined(ACQ_TASK)
+    uint32_t m_tSample = 0;                       //!< time of last sampling acquisition
+    #endif
+    bool m_fEventReq = false;                     //!< event uplink requested
+    bool m_fEventFailed = false;                  //!< last event uplink failed
+    uint32_t m_tEvent = 0;                        //!< time of last event uplink (0: none)
+    #if !defined(SLEEP_EN)
+    uint32_t m_tState = 0;                        //!< time of last uplink scheduler update
+    uint32_t m_tPoll = 0;                         //!< time of last inverter state polling
+    #endif
+    #if defined(CAPTURE_EN)
+    uint32_t m_tCapture = 0;                      //!< time of last capture uplink (0: none)
+    #endif
+    #if defined(ENABLE_TIMING)
+    int64_t m_tSend;                              //!< start of transmission [us]
+    uint8_t m_timingCount = 0;                    //!< uplinks since last timing report
+    #endif
 };
 
 /****************************************************************************\
@@ -599,11 +718,14 @@ Arduino_LoRaWAN::cEventLog myEventLog;
 // configuration to the library (perhaps you're just testing).
 // This pinmap matches the FeatherM0 LoRa. See the arduino-lmic
 // docs for more info on how to set this up.
+// PIN_NONE is mapped to LMIC_UNUSED_PIN.
+static_assert(static_cast<uint8_t>(PIN_NONE) == cMyLoRaWAN::lmic_pinmap::LMIC_UNUSED_PIN, "PIN_NONE != LMIC_UNUSED_PIN");
+
 const cMyLoRaWAN::lmic_pinmap myPinMap = {
-     .nss = PIN_LMIC_NSS,
+     .nss = static_cast<uint8_t>(board.lmicNss),
      .rxtx = cMyLoRaWAN::lmic_pinmap::LMIC_UNUSED_PIN,
-     .rst = PIN_LMIC_RST,
-     .dio = { PIN_LMIC_DIO0, PIN_LMIC_DIO1, PIN_LMIC_DIO2 },
+     .rst = static_cast<uint8_t>(board.lmicRst),
+     .dio = { static_cast<uint8_t>(board.lmicDio0), static_cast<uint8_t>(board.lmicDio1), static_cast<uint8_t>(board.lmicDio2) },
      .rxtx_rx_active = 0,
      .rssi_cal = 0,
      .spi_freq = 8000000,
@@ -623,6 +745,13 @@ RTC_DATA_ATTR bool                            runtimeExpired = false;   //!< fla
 RTC_DATA_ATTR uint32_t                        tReference[NUM_PORTS] = { 0 };        //!< time of last uplink
 RTC_DATA_ATTR bool                            longSleep;                //!< last sleep interval; 0 - normal / 1 - long
 
+#if defined(SLEEP_EN)
+    RTC_DATA_ATTR uint32_t                    sleepCycle = 0;           //!< no. of wake-ups from sleep (uplink schedule)
+    RTC_DATA_ATTR Snapshot                    rtcSnapshot;              //!< last good Modbus data
+    RTC_DATA_ATTR time_t                      rtcSnapshotTime = 0;      //!< time of last good Modbus data
+    RTC_DATA_ATTR uint8_t                     offlineSkip = 0;          //!< no. of wake-ups to skip Modbus (inverter offline)
+#endif
+
 #if defined(GET_NETWORKTIME)
     RTC_DATA_ATTR time_t                      rtcLastClockSync = 0;     //!< timestamp of last RTC synchonization to network time
 #endif
@@ -635,19 +764,71 @@ Preferences preferences;
 struct sPrefs {
 uint16_t  sleep_interval;       //!< preferences: sleep interval
 uint16_t  sleep_interval_long;  //!< preferences: sleep interval long
+#if defined(RBE_EN)
+uint16_t  deadband[RBE_NUM_FIELDS]; //!< preferences: report by exception deadbands
+uint8_t   heartbeat;            //!< preferences: report by exception heartbeat
+#endif
+uint8_t   confirm_every;        //!< preferences: confirmed uplink interval
+uint8_t   ack_rate_min;         //!< preferences: min. ACK rate
+int8_t    margin_min;           //!< preferences: min. link margin
+uint16_t  idle_interval;        //!< preferences: uplink interval while idle
+uint16_t  min_power;            //!< preferences: min. output power in production
+uint8_t   night_start;          //!< preferences: start of night window
+uint8_t   night_end;            //!< preferences: end of night window
 } prefs;
 
+/// Preferences modified by downlink - to be saved
+bool prefsDirty = false;
+
+/// Load preferences from flash
+void loadPrefs(void);
+
+/// Save preferences to flash
+void savePrefs(void);
+
+/// Apply preferences to modules
+void applyPrefs(void);
+
 /// Force sleep mode after <sleepTimeout> has been reached (if FORCE_SLEEP is defined) 
 ostime_t sleepTimeout;
 
 /// RTC sync request flag - set (if due) in setup() / cleared in UserRequestNetworkTimeCb()
 bool rtcSyncReq = false;
 
+/// Determine sleep duration and enter Deep Sleep Mode
+void prepareSleep(void);
+
+/// Local hour of day (-1: unknown)
+int localHour(void);
+
+/// Max. application payload size at current data rate
+uint8_t maxPayloadSize(void);
+
+/// Link margin of last downlink in dB
+int8_t linkMargin(void);
+
     /// Sleep request
     bool sleepReq = false;
 
-    /// Uplink request - command received via downlink
+    /// Commands answered by a response uplink (bit n of uplinkReq: uplinkReqCmds[n])
+    static const uint8_t uplinkReqCmds[] = {
+        CMD_GET_DATETIME,
+        CMD_GET_CONFIG,
+        CMD_GET_STATS,
+        CMD_GET_INVERTER_SETTINGS,
+        CMD_SET_POWER_LIMIT
+    };
+
+    /// Uplink requests - bitmap of pending response uplinks (0: none)
     uint8_t uplinkReq = 0;
+
+    /// Request response uplink for command
+    static void requestUplink(uint8_t cmd) {
+        for (uint8_t i = 0; i < sizeof(uplinkReqCmds); i++) {
+            if (uplinkReqCmds[i] == cmd)
+                uplinkReq |= (1 << i);
+        }
+    }
 #if defined(GET_NETWORKTIME)
 
 
@@ -658,9 +839,6 @@ bool rtcSyncReq = false;
     ESP32Time rtc;
 #endif
 
-/// Modbus interface select: 0 - USB / 1 - RS485
-bool modbusRS485;
-
 /****************************************************************************\
 |
 |	Provisioning info for LoRaWAN OTAA
@@ -713,33 +891,31 @@ bool modbusRS485;
 
 /// Arduino setup
 void setup() {
+    stats_inc(rtStats.wakeups);
 
-    pinMode(INTERFACE_SEL, INPUT_PULLUP);
-    modbusRS485 = digitalRead(INTERFACE_SEL);
-    
+    // select Modbus interface (only MODBUS_IF_AUTO: read interface select pin)
+    ModbusLink::select();
 
     // set baud rate
-    if (modbusRS485) {
+    if (ModbusLink::rs485()) {
         Serial.begin(115200);
         log_d("Modbus interface: RS485");
     } else {
         Serial.setDebugOutput(false);
-        DEBUG_PORT.begin(115200, SERIAL_8N1, DEBUG_RX, DEBUG_TX);
+        DEBUG_PORT.begin(115200, SERIAL_8N1, board.debugRx, board.debugTx);
         DEBUG_PORT.setDebugOutput(true);
         log_d("Modbus interface: USB");
     }
+    log_d("Board: %s", board.name);
     
     // wait for DEBUG_PORT to be ready
     //while (! DEBUG_PORT)
     //    yield();
     delay(500);
    
-    preferences.begin("GROWATT2LORAWAN", false);
-    prefs.sleep_interval      = preferences.getUShort("sleep_interval", SLEEP_INTERVAL);
-    log_d("Preferences: sleep_interval:        %u s", prefs.sleep_interval);
-    prefs.sleep_interval_long = preferences.getUShort("sleep_interval_long", SLEEP_INTERVAL_LONG);
-    log_d("Preferences: sleep_interval_long:   %u s", prefs.sleep_interval_long);
-    preferences.end();
+    loadPrefs();
+    applyPrefs();
+    settingsCache.begin();
 
     sleepTimeout = sec2osticks(SLEEP_TIMEOUT_INITIAL);
 
@@ -763,8 +939,17 @@ void setup() {
 
     // set up the sensors.
     mySensor.setup();
+    #if defined(RINGLOG_EN)
+        ringLog.begin();
+    #endif
     DEBUG_PRINTF("mySensor.setup() - done");
 
+    #if defined(ACQ_TASK) && !defined(GEN_PAYLOAD)
+        // start Modbus data acquisition task
+        startAcqTask();
+        DEBUG_PRINTF("startAcqTask() - done");
+    #endif
+
     // set up lorawan.
     myLoRaWAN.setup();
     DEBUG_PRINTF("myLoRaWAN.setup() - done");
@@ -785,15 +970,30 @@ void loop() {
     mySensor.loop();
     myEventLog.loop();
 
+    // report result of power limit request
+    if (powerLimit.hasReport() && (uplinkReq == 0)) {
+        requestUplink(CMD_SET_POWER_LIMIT);
+    }
+
     if (uplinkReq != 0) {
       myLoRaWAN.doCfgUplink();
     }
 
+    #ifdef SLEEP_EN
+        if (sleepReq & !rtcSyncReq) {
+            if (!mySensor.isUplinkPending() && !myLoRaWAN.isBusy() && (uplinkReq == 0) && !powerLimit.isDue()) {
+                DEBUG_PRINTF("Shutdown()");
+                myLoRaWAN.Shutdown();
+                prepareSleep();
+            }
+        }
+    #endif
 
     #ifdef FORCE_SLEEP
         if ((os_getTime() > sleepTimeout) & !rtcSyncReq) {
             DEBUG_PRINTF_TS("Sleep timer expired!");
             DEBUG_PRINTF("Shutdown()");
+            stats_add(rtStats.wakeTime, millis());
             runtimeExpired = true;
             myLoRaWAN.Shutdown();
             magicFlag1 = 0;
@@ -803,6 +1003,187 @@ void loop() {
     #endif
 }
 
+/****************************************************************************\
+|
+|	Preferences
+|
+\****************************************************************************/
+
+//
+// Load preferences from flash
+//
+// All preferences are stored as one blob; if the blob is missing or has
+// a different layout, the legacy keys or the default values are used.
+//
+void
+loadPrefs(void) {
+    preferences.begin("GROWATT2LORAWAN", false);
+    if (preferences.getBytes("prefs", &prefs, sizeof(prefs)) != sizeof(prefs)) {
+        prefs.sleep_interval      = preferences.getUShort("sleep_interval", SLEEP_INTERVAL);
+        prefs.sleep_interval_long = preferences.getUShort("sleep_interval_long", SLEEP_INTERVAL_LONG);
+        #if defined(RBE_EN)
+            const uint16_t deadband[RBE_NUM_FIELDS] = RBE_DEADBAND;
+            memcpy(prefs.deadband, deadband, sizeof(prefs.deadband));
+            prefs.heartbeat = RBE_HEARTBEAT;
+        #endif
+        prefs.confirm_every = POLICY_CONFIRM_EVERY;
+        prefs.ack_rate_min  = POLICY_ACK_RATE_MIN;
+        prefs.margin_min    = POLICY_MARGIN_MIN;
+        prefs.idle_interval = SCHED_IDLE_INTERVAL;
+        prefs.min_power     = SCHED_MIN_POWER;
+        prefs.night_start   = SCHED_NIGHT_START;
+        prefs.night_end     = SCHED_NIGHT_END;
+    }
+    preferences.end();
+
+    log_d("Preferences: sleep_interval:        %u s", prefs.sleep_interval);
+    log_d("Preferences: sleep_interval_long:   %u s", prefs.sleep_interval_long);
+    #if defined(RBE_EN)
+        log_d("Preferences: heartbeat:             %u", prefs.heartbeat);
+    #endif
+    log_d("Preferences: uplink policy:         1/%u, %u %%, %d dB", prefs.confirm_every, prefs.ack_rate_min, prefs.margin_min);
+    log_d("Preferences: schedule:              %u min, %u W, %u-%u h", prefs.idle_interval, prefs.min_power, prefs.night_start, prefs.night_end);
+}
+
+//
+// Save preferences to flash (one NVS commit)
+//
+void
+savePrefs(void) {
+    preferences.begin("GROWATT2LORAWAN", false);
+    preferences.putBytes("prefs", &prefs, sizeof(prefs));
+    preferences.end();
+    prefsDirty = false;
+    log_d("Preferences saved");
+}
+
+//
+// Apply preferences to modules
+//
+void
+applyPrefs(void) {
+    #if defined(RBE_EN)
+        rbe_config(prefs.deadband, prefs.heartbeat);
+    #endif
+    uplinkPolicy.config(prefs.confirm_every, prefs.ack_rate_min, prefs.margin_min);
+    uplinkScheduler.config(prefs.idle_interval, prefs.min_power, prefs.night_start, prefs.night_end);
+}
+
+
+/****************************************************************************\
+|
+|	Downlink command handlers
+|
+\****************************************************************************/
+
+// Request response uplink (see doCfgUplink())
+static bool
+cmdGet(const uint8_t *cmd) {
+    log_d("Get 0x%02X", cmd[0]);
+    requestUplink(cmd[0]);
+    return true;
+}
+
+static bool
+cmdSetDateTime(const uint8_t *cmd) {
+    time_t set_time = cmd[4] | (cmd[3] << 8) | (cmd[2] << 16) | (cmd[1] << 24);
+    rtc.setTime(set_time);
+    rtcLastClockSync = rtc.getLocalEpoch();
+    #if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_DEBUG
+        char tbuf[25];
+        struct tm timeinfo;
+   
+        localtime_r(&set_time, &timeinfo);
+        strftime(tbuf, 25, "%Y-%m-%d %H:%M:%S", &timeinfo);
+        log_d("Set date/time: %s", tbuf);
+    #endif
+    return true;
+}
+
+static bool
+cmdSetSleepInterval(const uint8_t *cmd) {
+    prefs.sleep_interval = cmd[2] | (cmd[1] << 8);
+    log_d("Set sleep_interval: %u s", prefs.sleep_interval);
+    prefsDirty = true;
+    return true;
+}
+
+static bool
+cmdSetSleepIntervalLong(const uint8_t *cmd) {
+    prefs.sleep_interval_long = cmd[2] | (cmd[1] << 8);
+    log_d("Set sleep_interval_long: %u s", prefs.sleep_interval_long);
+    prefsDirty = true;
+    return true;
+}
+
+#if defined(RBE_EN)
+static bool
+cmdSetDeadband(const uint8_t *cmd) {
+    if (cmd[1] >= RBE_NUM_FIELDS)
+        return false;
+    prefs.deadband[cmd[1]] = cmd[3] | (cmd[2] << 8);
+    log_d("Set deadband[%u]: %u", cmd[1], prefs.deadband[cmd[1]]);
+    prefsDirty = true;
+    return true;
+}
+
+static bool
+cmdSetHeartbeat(const uint8_t *cmd) {
+    prefs.heartbeat = cmd[1];
+    log_d("Set heartbeat: %u", prefs.heartbeat);
+    prefsDirty = true;
+    return true;
+}
+#endif
+
+static bool
+cmdSetPowerLimit(const uint8_t *cmd) {
+    log_d("Set power limit: %u %%", cmd[1]);
+    return powerLimit.request(cmd[1]);
+}
+
+static bool
+cmdSetUplinkPolicy(const uint8_t *cmd) {
+    prefs.confirm_every = cmd[1];
+    prefs.ack_rate_min  = cmd[2];
+    prefs.margin_min    = (int8_t)cmd[3];
+    log_d("Set uplink policy: 1/%u, %u %%, %d dB", prefs.confirm_every, prefs.ack_rate_min, prefs.margin_min);
+    prefsDirty = true;
+    return true;
+}
+
+static bool
+cmdSetSchedule(const uint8_t *cmd) {
+    if ((cmd[5] > 23) || (cmd[6] > 23))
+        return false;
+    prefs.idle_interval = cmd[2] | (cmd[1] << 8);
+    prefs.min_power     = cmd[4] | (cmd[3] << 8);
+    prefs.night_start   = cmd[5];
+    prefs.night_end     = cmd[6];
+    log_d("Set schedule: %u min, %u W, %u-%u h", prefs.idle_interval, prefs.min_power, prefs.night_start, prefs.night_end);
+    prefsDirty = true;
+    return true;
+}
+
+/// Downlink commands: opcode, length, handler
+static const DownlinkCmd downlinkCmds[] = {
+    {CMD_GET_DATETIME,              1, cmdGet},
+    {CMD_GET_CONFIG,                1, cmdGet},
+    {CMD_GET_STATS,                 1, cmdGet},
+    {CMD_GET_INVERTER_SETTINGS,     1, cmdGet},
+    {CMD_SET_DATETIME,              5, cmdSetDateTime},
+    {CMD_SET_POWER_LIMIT,           2, cmdSetPowerLimit},
+    {CMD_SET_SLEEP_INTERVAL,        3, cmdSetSleepInterval},
+    {CMD_SET_SLEEP_INTERVAL_LONG,   3, cmdSetSleepIntervalLong},
+    #if defined(RBE_EN)
+    {CMD_SET_DEADBAND,              4, cmdSetDeadband},
+    {CMD_SET_HEARTBEAT,             2, cmdSetHeartbeat},
+    #endif
+    {CMD_SET_UPLINK_POLICY,         4, cmdSetUplinkPolicy},
+    {CMD_SET_SCHEDULE,              7, cmdSetSchedule}
+};
+
+
 /****************************************************************************\
 |
 |	LoRaWAN methods
@@ -816,56 +1197,16 @@ void ReceiveCb(
     const uint8_t *pBuffer,
     size_t nBuffer) {
             
-    uplinkReq = 0;
     log_v("Port: %d", uPort);
-    char buf[255];
-    *buf = '\0';
 
-    if (uPort > 0) {
-        for (int i = 0; i < nBuffer; i++) {
-              sprintf(&buf[strlen(buf)], "%02X ", pBuffer[i]);
-        }
-        log_v("Data: %s", buf);
+    if ((uPort > 0) && (nBuffer > 0)) {
+        uint8_t n = downlink_dispatch(downlinkCmds, sizeof(downlinkCmds) / sizeof(DownlinkCmd), pBuffer, nBuffer);
+        log_d("Downlink: %u command(s) executed", n);
 
-        if ((pBuffer[0] == CMD_GET_DATETIME) && (nBuffer == 1)) {
-            log_d("Get date/time");
-            uplinkReq = CMD_GET_DATETIME;
-        }
-        if ((pBuffer[0] == CMD_GET_CONFIG) && (nBuffer == 1)) {
-            log_d("Get config");
-            uplinkReq = CMD_GET_CONFIG; 
-        }
-        if ((pBuffer[0] == CMD_GET_INVERTER_SETTINGS) && (nBuffer == 1)) {
-            log_d("Get inverter settings");
-            uplinkReq = CMD_GET_INVERTER_SETTINGS;
-        }
-        if ((pBuffer[0] == CMD_SET_DATETIME) && (nBuffer == 5)) {
-            
-            time_t set_time = pBuffer[4] | (pBuffer[3] << 8) | (pBuffer[2] << 16) | (pBuffer[1] << 24);
-            rtc.setTime(set_time);
-            rtcLastClockSync = rtc.getLocalEpoch();
-            #if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_DEBUG
-                char tbuf[25];
-                struct tm timeinfo;
-           
-                localtime_r(&set_time, &timeinfo);
-                strftime(tbuf, 25, "%Y-%m-%d %H:%M:%S", &timeinfo);
-                log_d("Set date/time: %s", tbuf);
-            #endif
-        }
-        if ((pBuffer[0] == CMD_SET_SLEEP_INTERVAL) && (nBuffer == 3)){
-            prefs.sleep_interval = pBuffer[2] | (pBuffer[1] << 8);
-            log_d("Set sleep_interval: %u s", prefs.sleep_interval);
-            preferences.begin("BWS-TTN", false);
-            preferences.putUShort("sleep_interval", prefs.sleep_interval);
-            preferences.end();            
-        }
-        if ((pBuffer[0] == CMD_SET_SLEEP_INTERVAL_LONG) && (nBuffer == 3)){
-            prefs.sleep_interval_long = pBuffer[2] | (pBuffer[1] << 8);
-            log_d("Set sleep_interval_long: %u s", prefs.sleep_interval_long);
-            preferences.begin("BWS-TTN", false);
-            preferences.putUShort("sleep_interval", prefs.sleep_interval_long);
-            preferences.end();            
+        // save all modified preferences at once
+        if (prefsDirty) {
+            savePrefs();
+            applyPrefs();
         }
     }
     if (uplinkReq == 0) {
@@ -965,6 +1306,11 @@ if (rtcSyncReq) {
 void
 cMyLoRaWAN::NetTxComplete(void) {
     DEBUG_PRINTF_TS("");
+    #ifdef SLEEP_EN
+        if (uplinkReq == 0) {
+            sleepReq = true;
+        }
+    #endif
 }
 
 // Print session info for debugging
@@ -1128,14 +1474,28 @@ cMyLoRaWAN::GetAbpProvisioningInfo(AbpProvisioningInfo *pAbpInfo) {
     }
 #endif
 
+/// Local hour of day (-1: unknown)
+int localHour(void) {
+    #if defined(GET_NETWORKTIME)
+        if (rtcLastClockSync) {
+            struct tm timeinfo;
+            time_t t_now = rtc.getLocalEpoch();
+            localtime_r(&t_now, &timeinfo);
+            return timeinfo.tm_hour;
+        }
+    #endif
+    return -1;
+}
+
 /// Determine sleep duration and enter Deep Sleep Mode
 void prepareSleep(void) {
-    uint32_t sleep_interval = prefs.sleep_interval;
+    // stretched while the inverter is idle (see uplinkScheduler.h)
+    uint32_t sleep_interval = uplinkScheduler.interval(prefs.sleep_interval);
     longSleep = false;
     #ifdef ADC_EN
         // Long sleep interval if battery is weak
         if (mySensor.getVoltage() < BATTERY_WEAK) {
-            sleep_interval = prefs.sleep_interval_long;
+            sleep_interval = max(sleep_interval, (uint32_t)prefs.sleep_interval_long);
             longSleep = true;
         }
     #endif
@@ -1151,6 +1511,10 @@ void prepareSleep(void) {
         sleep_interval += 20; // Added extra 20-secs of sleep to allow for slow ESP32 RTC timers
     }
     
+    stats_add(rtStats.wakeTime, millis());
+    #if defined(SLEEP_EN)
+        sleepCycle++;
+    #endif
     DEBUG_PRINTF_TS("Shutdown() - sleeping for %d s", sleep_interval);
     ESP.deepSleep(sleep_interval * 1000000LL);
 }
@@ -1237,15 +1601,25 @@ cMyLoRaWAN::doCfgUplink(void) {
 
     log_d("--- Uplink Configuration/Status ---");
     
-    uint8_t uplink_payload[5];
+    uint8_t uplink_payload[max(STATS_SIZE, SETTINGS_SIZE)];
     uint8_t port;
+    uint8_t cmd = 0;
+
+    // pending requests are answered in the order of uplinkReqCmds
+    for (uint8_t i = 0; i < sizeof(uplinkReqCmds); i++) {
+        if (uplinkReq & (1 << i)) {
+            cmd = uplinkReqCmds[i];
+            this->m_uplinkReq = (1 << i);
+            break;
+        }
+    }
 
     //
     // Encode data as byte array for LoRaWAN transmission
     //
     LoraEncoder encoder(uplink_payload);
 
-    if (uplinkReq == CMD_GET_DATETIME) {
+    if (cmd == CMD_GET_DATETIME) {
         log_d("Date/Time");
         port = 3;
         time_t t_now = rtc.getLocalEpoch();
@@ -1266,19 +1640,34 @@ cMyLoRaWAN::doCfgUplink(void) {
         // bits 4..7 esp32 sntp time status (not used)
         // TODO add flags for succesful LORA time sync/manual sync
         encoder.writeUint8((rtcSyncReq) ? 0x03 : 0x02);
-    } else if (uplinkReq == CMD_GET_CONFIG) {
+    } else if (cmd == CMD_GET_CONFIG) {
         log_d("Config");
         port = 4;
         encoder.writeUint8(prefs.sleep_interval >> 8);
         encoder.writeUint8(prefs.sleep_interval & 0xFF);
         encoder.writeUint8(prefs.sleep_interval_long >> 8);
         encoder.writeUint8(prefs.sleep_interval_long & 0xFF);
-    } else if (uplinkReq == CMD_GET_INVERTER_SETTINGS) {
+        encoder.writeUint8(prefs.idle_interval >> 8);
+        encoder.writeUint8(prefs.idle_interval & 0xFF);
+        encoder.writeUint8(prefs.min_power >> 8);
+        encoder.writeUint8(prefs.min_power & 0xFF);
+        encoder.writeUint8(prefs.night_start);
+        encoder.writeUint8(prefs.night_end);
+    } else if (cmd == CMD_GET_STATS) {
+        log_d("Statistics");
+        port = 7;
+        encode_stats(encoder);
+    } else if (cmd == CMD_GET_INVERTER_SETTINGS) {
         log_d("Inverter Settings");
         port = 5;
-        encoder.writeUint32(0xdeadbeef);
+        settingsCache.encode(encoder);
+    } else if (cmd == CMD_SET_POWER_LIMIT) {
+        log_d("Power Limit");
+        port = 6;
+        powerLimit.encode(encoder);
     } else {
-      log_v("");
+        log_v("");
+        uplinkReq = 0;
         return;
     }
 
@@ -1298,17 +1687,17 @@ cMyLoRaWAN::doCfgUplink(void) {
         [](void *pClientData, bool fSucccess) -> void {
             auto const pThis = (cMyLoRaWAN *)pClientData;
             pThis->m_fBusy = false;
-            uplinkReq = 0;
+            uplinkReq &= ~pThis->m_uplinkReq;
             log_v("Sending successful");
         },
         (void *)this,
-        /* confirmed */ true,
+        /* confirmed */ uplinkPolicy.isEscalated(),
         /* port */ port
         )) {
         // sending failed; callback has not been called and will not
         // be called. Reset busy flag.
         this->m_fBusy = false;
-        uplinkReq = 0;
+        uplinkReq &= ~this->m_uplinkReq;
         log_v("Sending failed");
     }
 }
@@ -1326,34 +1715,403 @@ cSensor::setup(std::uint32_t uplinkPeriodMs) {
     this->m_uplinkPeriodMs = uplinkPeriodMs;
     for (int idx=0; idx<NUM_PORTS; idx++)
         this->m_tReference[idx] = millis();
+
+    #if defined(SLEEP_EN)
+        // One wake-up per uplink period - request all ports due in this cycle
+        for (int idx=0; idx<NUM_PORTS; idx++)
+            this->m_fUplinkRequest[idx] = (sleepCycle % UplinkSchedule[idx].mult) == 0;
+
+        // events not acknowledged before sleep
+        this->m_fEventReq = faultEvents.pending() > 0;
+    #endif
     
     // Initialize your sensors here...
+    // (Modbus interface is initialized with the first acquisition, see modbusSession.h)
 }
 
 void
 cSensor::loop(void) {
+    #if !defined(SLEEP_EN)
     auto const tNow = millis();
-    
+
+    // update inverter state; request all ports on fault/warning changes
+    if (tNow - this->m_tState >= 1000UL) {
+        Snapshot snap;
+
+        this->m_tState = tNow;
+        if (modbusSnapshot.read(snap)) {
+            if (faultEvents.update(snap, time(nullptr)))
+                this->m_fEventReq = true;
+            if (uplinkScheduler.update(snap, localHour())) {
+                log_d("Scheduler: immediate uplink");
+                for (uint8_t idx=0; idx<NUM_PORTS; idx++)
+                    this->m_fUplinkRequest[idx] = true;
+            }
+        }
+    }
+
+    // retry failed event uplink
+    if (this->m_fEventFailed && !this->m_fEventReq && faultEvents.pending())
+        this->m_fEventReq = true;
+    #endif
+
+    // fault/warning events preempt the uplink schedule (rate limited)
+    if (this->m_fEventReq && !this->m_fBusy && !m_acq.isBusy()) {
+        uint32_t const holdoff = (this->m_fEventFailed ? EVENT_RETRY : EVENT_INTERVAL) * 1000UL;
+        if (!this->m_tEvent || (millis() - this->m_tEvent >= holdoff))
+            this->doEvents();
+    }
+
+    #if !defined(SLEEP_EN)
+    // uplink period depends on inverter state
+    auto const uplinkPeriodMs = uplinkScheduler.interval(this->m_uplinkPeriodMs / 1000) * 1000UL;
 
     for (uint8_t idx=0; idx<NUM_PORTS; idx++) {
         //auto const deltaT = tNow - this->m_tReference[idx];
         auto const deltaT = tNow - tReference[idx];
-        if (deltaT >= this->m_uplinkPeriodMs * UplinkSchedule[idx].mult) {
+        if (deltaT >= uplinkPeriodMs * UplinkSchedule[idx].mult) {
             // request an uplink
             this->m_fUplinkRequest[idx] = true;
 
             // keep trigger time locked to uplinkPeriod
-            auto const advance = deltaT / this->m_uplinkPeriodMs;
+            auto const advance = deltaT / uplinkPeriodMs;
             //this->m_tReference[idx] += advance * this->m_uplinkPeriodMs;
-            tReference[idx] += advance * this->m_uplinkPeriodMs;
+            tReference[idx] += advance * uplinkPeriodMs;
+        }
+
+    }
+    #endif
+
+    // if uplinks were requested, start data acquisition
+    // (or send latest snapshot if data is acquired by the acquisition task)
+    uint8_t due = 0;
+    for (uint8_t idx=0; idx<NUM_PORTS; idx++) {
+        if (this->m_fUplinkRequest[idx])
+            due |= PAYLOAD_GROUP(UplinkSchedule[idx].port);
+    }
+    if (due && !this->m_fBusy && !m_acq.isBusy()) {
+        uint8_t groups = selectGroups(due);
+        #if defined(ACQ_TASK) && !defined(GEN_PAYLOAD)
+        if (modbusSnapshot.isValid())
+        #endif
+        {
+            for (uint8_t idx=0; idx<NUM_PORTS; idx++) {
+                if (groups & PAYLOAD_GROUP(UplinkSchedule[idx].port))
+                    this->m_fUplinkRequest[idx] = false;
+            }
+            #if defined(GEN_PAYLOAD) || defined(ACQ_TASK)
+                this->doUplink(groups);
+            #elif defined(SLEEP_EN)
+                if (offlineSkip) {
+                    // inverter offline - send status only
+                    log_d("Inverter offline - skipping Modbus (%u)", offlineSkip);
+                    offlineSkip--;
+                    this->doUplink(groups);
+                } else {
+                    m_acq.start(groups);
+                }
+            #else
+                m_acq.start(groups);
+            #endif
         }
+    }
 
-        // if an uplink was requested, do it.
-        if (this->m_fUplinkRequest[idx] && !this->m_fBusy) {
-            this->m_fUplinkRequest[idx] = false;
-            this->doUplink(UplinkSchedule[idx].port);
+    #if !defined(ACQ_TASK) && !defined(GEN_PAYLOAD)
+        // execute power limit request without waiting for the next uplink
+        if (!due && !m_acq.isBusy() && powerLimit.isDue()) {
+            m_acq.start(0);
         }
-    }    
+    #endif
+
+    #if !defined(PAYLOAD_AGG) && !defined(ACQ_TASK) && !defined(GEN_PAYLOAD) && !defined(SLEEP_EN)
+        // poll inverter state between uplinks (uplink scheduler)
+        if (!due && !m_acq.isBusy() && (millis() - this->m_tPoll >= SCHED_POLL_INTERVAL * 1000UL)) {
+            this->m_tPoll = millis();
+            m_acq.start(PAYLOAD_GROUP_STATE);
+        }
+    #endif
+
+    #if defined(PAYLOAD_AGG) && !defined(ACQ_TASK) && !defined(GEN_PAYLOAD)
+        // sample Modbus data for aggregation between uplinks
+        if (!due && !m_acq.isBusy() && (millis() - this->m_tSample >= UPDATE_MODBUS * 1000UL)) {
+            this->m_tSample = millis();
+            m_acq.start(PAYLOAD_GROUP_AGG);
+        }
+    #endif
+
+    #if defined(CAPTURE_EN) && !defined(ACQ_TASK) && !defined(GEN_PAYLOAD)
+        // poll grid frequency/voltage (grid capture)
+        if (!due && !m_acq.isBusy() && gridCapture.isDue()) {
+            m_acq.start(PAYLOAD_GROUP_CAPTURE);
+        }
+    #endif
+
+    // advance data acquisition; send uplink when completed
+    if (m_acq.step()) {
+        #if defined(SLEEP_EN)
+            updateCache();
+        #endif
+        // sampling, state polling, grid capture or power limit only - no uplink
+        if (m_acq.getGroups() & PAYLOAD_GROUPS_ALL)
+            this->doUplink(m_acq.getGroups());
+    }
+
+    #if defined(RINGLOG_EN)
+        // send stored readings while the link is up (rate limited)
+        #if !defined(SLEEP_EN)
+            if (this->m_tBackfill && (millis() - this->m_tBackfill >= BACKFILL_INTERVAL * 1000UL) &&
+                (ringLog.pending() > 0)) {
+                this->m_fBackfillReq = true;
+            }
+        #endif
+        if (this->m_fBackfillReq && !due && !this->m_fBusy && !m_acq.isBusy()) {
+            this->doBackfill();
+        }
+    #endif
+
+    #if defined(CAPTURE_EN)
+        // send frozen capture window in chunks (rate limited)
+        if (gridCapture.isReady() && !due && !this->m_fBusy && !m_acq.isBusy() &&
+            (!this->m_tCapture || (millis() - this->m_tCapture >= CAPTURE_UPLINK_INTERVAL * 1000UL))) {
+            this->doCapture();
+        }
+    #endif
+}
+
+#if defined(RINGLOG_EN)
+//
+// Write sample of failed uplink to ring log
+//
+void
+cSensor::logSample(void) {
+    this->m_tBackfill = 0;
+    if (this->m_sampleLen) {
+        ringLog.write(this->m_sampleTime, this->m_sample, this->m_sampleLen);
+        this->m_sampleLen = 0;
+    }
+}
+
+//
+// Send batch of stored readings
+//
+// Backfill payload (port PAYLOAD_PORT_BACKFILL):
+// byte 0: no. of records
+// per record:
+// uint32  timestamp (UNIX time)
+// sample  (see encode_sample())
+//
+void
+cSensor::doBackfill(void) {
+    if (myLoRaWAN.isBusy() || (LMIC.opmode & (OP_POLL | OP_TXDATA | OP_TXRXPEND))) {
+        return;
+    }
+    this->m_fBackfillReq = false;
+
+    RingRecord recs[RINGLOG_BATCH];
+    uint8_t max = (maxPayloadSize() - 1) / (4 + SAMPLE_SIZE);
+    uint8_t n = ringLog.read(recs, min(max, (uint8_t)RINGLOG_BATCH));
+    if (n == 0)
+        return;
+
+    log_d("Backfill: %u of %u records", n, ringLog.pending());
+    LoraEncoder encoder(loraData);
+    encoder.writeUint8(n);
+    for (uint8_t i = 0; i < n; i++) {
+        encoder.writeUint32(recs[i].time);
+        for (uint8_t j = 0; j < SAMPLE_SIZE; j++)
+            encoder.writeUint8(recs[i].data[j]);
+    }
+
+    this->m_fBusy = true;
+    if (! myLoRaWAN.SendBuffer(
+        loraData, encoder.getLength(),
+        // this is the completion function:
+        [](void *pClientData, bool fSucccess) -> void {
+            auto const pThis = (cSensor *)pClientData;
+            pThis->m_fBusy = false;
+            if (fSucccess) {
+                ringLog.markSent();
+                pThis->m_tBackfill = millis();
+            } else {
+                pThis->m_tBackfill = 0;
+            }
+        },
+        (void *)this,
+        /* confirmed */ true,
+        /* port */ PAYLOAD_PORT_BACKFILL
+        )) {
+        // sending failed; callback has not been called and will not
+        // be called. Reset busy flag.
+        this->m_fBusy = false;
+        this->m_tBackfill = 0;
+    }
+}
+#endif
+
+//
+// Send queued fault/warning events (see faultEvents.h)
+//
+void
+cSensor::doEvents(void) {
+    if (myLoRaWAN.isBusy() || (LMIC.opmode & (OP_POLL | OP_TXDATA | OP_TXRXPEND))) {
+        return;
+    }
+    this->m_fEventReq = false;
+
+    LoraEncoder encoder(loraData);
+    uint8_t n = faultEvents.encode(encoder, (maxPayloadSize() - 2) / EVENT_SIZE);
+    if (n == 0)
+        return;
+
+    log_d("Events: %u of %u", n, faultEvents.pending());
+    this->m_tEvent = millis();
+    this->m_fBusy = true;
+    if (! myLoRaWAN.SendBuffer(
+        loraData, encoder.getLength(),
+        // this is the completion function:
+        [](void *pClientData, bool fSucccess) -> void {
+            auto const pThis = (cSensor *)pClientData;
+            pThis->m_fBusy = false;
+            faultEvents.ack(fSucccess);
+            pThis->m_fEventFailed = !fSucccess;
+            if (fSucccess)
+                pThis->m_fEventReq = (faultEvents.pending() > 0);
+        },
+        (void *)this,
+        /* confirmed */ true,
+        /* port */ PAYLOAD_PORT_EVENTS
+        )) {
+        // sending failed; callback has not been called and will not
+        // be called. Reset busy flag.
+        this->m_fBusy = false;
+        faultEvents.ack(false);
+        this->m_fEventFailed = true;
+    }
+}
+
+#if defined(CAPTURE_EN)
+//
+// Send next chunk of frozen grid capture window (see gridCapture.h)
+//
+void
+cSensor::doCapture(void) {
+    if (myLoRaWAN.isBusy() || (LMIC.opmode & (OP_POLL | OP_TXDATA | OP_TXRXPEND))) {
+        return;
+    }
+
+    LoraEncoder encoder(loraData);
+    uint8_t n = gridCapture.encode(encoder, maxPayloadSize());
+    if (n == 0)
+        return;
+
+    log_d("Capture: %u samples, %u bytes", n, encoder.getLength());
+    this->m_tCapture = millis();
+    this->m_fBusy = true;
+    if (! myLoRaWAN.SendBuffer(
+        loraData, encoder.getLength(),
+        // this is the completion function:
+        [](void *pClientData, bool fSucccess) -> void {
+            auto const pThis = (cSensor *)pClientData;
+            pThis->m_fBusy = false;
+            // chunk is sent again after failure
+            if (fSucccess)
+                gridCapture.sent();
+        },
+        (void *)this,
+        /* confirmed */ false,
+        /* port */ PAYLOAD_PORT_CAPTURE
+        )) {
+        // sending failed; callback has not been called and will not
+        // be called. Reset busy flag.
+        this->m_fBusy = false;
+    }
+}
+#endif
+
+#if defined(SLEEP_EN)
+//
+// Keep last good Modbus data in RTC RAM,
+// check if the inverter is offline and update the uplink scheduler
+//
+void
+cSensor::updateCache(void) {
+    Snapshot snap;
+
+    if (!modbusSnapshot.read(snap))
+        return;
+
+    if (snap.result == growattIF::Success) {
+        rtcSnapshot     = snap;
+        rtcSnapshotTime = time(nullptr);
+        offlineSkip     = 0;
+    } else if (snap.result == ModbusTransport::ku8MBResponseTimedOut) {
+        offlineSkip     = OFFLINE_RETRY - 1;
+    }
+    uplinkScheduler.update(snap, localHour());
+    if (faultEvents.update(snap, time(nullptr)))
+        this->m_fEventReq = true;
+}
+#endif
+
+//
+// Max. application payload size at current data rate
+//
+uint8_t
+maxPayloadSize(void)
+{
+    #if defined(CFG_eu868)
+        static const uint8_t maxSize[] = { 51, 51, 51, 115, 222, 222, 222, 222 };
+    #elif defined(CFG_us915)
+        static const uint8_t maxSize[] = { 11, 53, 125, 242, 242 };
+    #elif defined(CFG_au915)
+        static const uint8_t maxSize[] = { 51, 51, 51, 115, 222, 222, 222 };
+    #else
+        static const uint8_t maxSize[] = { PAYLOAD_SIZE };
+    #endif
+
+    if (LMIC.datarate >= sizeof(maxSize))
+        return PAYLOAD_SIZE;
+    return min(maxSize[LMIC.datarate], PAYLOAD_SIZE);
+}
+
+//
+// Link margin of last downlink (SNR above the demodulation floor
+// of the current spreading factor: SF7 -7.5 dB ... SF12 -20 dB)
+//
+int8_t
+linkMargin(void)
+{
+    // LMIC.snr is in 0.25 dB steps
+    return (LMIC.snr + 20 + 10 * getSf(LMIC.rps)) / 4;
+}
+
+//
+// Select data groups to be sent in the next uplink
+//
+// All due groups are merged into one uplink if they fit into the max. payload
+// size at the current data rate; otherwise the groups are sent one by one.
+//
+uint8_t
+cSensor::selectGroups(uint8_t due)
+{
+    #if (PAYLOAD_VERSION == 2)
+        uint8_t groups = due & -due;
+
+        if ((due & (due - 1)) && (payload_size(due) <= maxPayloadSize())) {
+            groups = due;
+        }
+        #if defined(PAYLOAD_AGG)
+            // add aggregated data to port 1 data if it fits
+            if ((groups & PAYLOAD_GROUP(1)) &&
+                (payload_size(groups | PAYLOAD_GROUP_AGG) <= maxPayloadSize())) {
+                groups |= PAYLOAD_GROUP_AGG;
+            }
+        #endif
+        return groups;
+    #else
+        // lowest due group
+        return due & -due;
+    #endif
 }
 
 //
@@ -1400,15 +2158,17 @@ cSensor::getTemperature(void)
 // Prepare uplink data for transmission
 //
 void
-cSensor::doUplink(int port) {
+cSensor::doUplink(uint8_t groups) {
     // if busy uplinking, just skip
     if (this->m_fBusy|| myLoRaWAN.isBusy()) {
         DEBUG_PRINTF_TS("busy");
+        stats_inc(rtStats.uplinkBusy);
         return;
     }
     // if LMIC is busy, just skip
     if (LMIC.opmode & (OP_POLL | OP_TXDATA | OP_TXRXPEND)) {
         DEBUG_PRINTF_TS("other operation in progress");    
+        stats_inc(rtStats.uplinkBusy);
         return;
     }
     
@@ -1422,28 +2182,149 @@ cSensor::doUplink(int port) {
     #endif
 
     LoraEncoder encoder(loraData);
+    Snapshot snap;
     #ifdef GEN_PAYLOAD
-        gen_payload(port, encoder);
+        gen_payload(snap.data);
+        snap.result = growattIF::Success;
+    #elif defined(SLEEP_EN)
+        if (!modbusSnapshot.read(snap)) {
+            // Modbus skipped (inverter offline) - last good data with status "timed out"
+            snap        = rtcSnapshot;
+            snap.result = ModbusTransport::ku8MBResponseTimedOut;
+        }
     #else
-        get_payload(port, encoder);
+        modbusSnapshot.read(snap);
+    #endif
+
+    #if defined(RBE_EN)
+    if (NUM_SLAVES == 1) {
+        // report by exception - send changed data groups only
+        groups = rbe_filter(groups, snap.result, snap.data);
+        if (groups == 0) {
+            log_d("Data unchanged - uplink skipped");
+            #if defined(SLEEP_EN)
+                if (uplinkReq == 0) {
+                    sleepReq = true;
+                }
+            #endif
+            return;
+        }
+    }
+    #endif
+
+    TIMING_BEGIN(tEncode);
+    uint8_t port;
+    #if (PAYLOAD_VERSION == 2)
+    if (NUM_SLAVES > 1) {
+        // multiple inverters - summary of all inverters
+        Snapshot snaps[MAX_SLAVES];
+        for (uint8_t i = 0; i < NUM_SLAVES; i++) {
+            #ifdef GEN_PAYLOAD
+                gen_payload(snaps[i].data);
+                snaps[i].result = growattIF::Success;
+            #else
+                if (!slaveSnapshot[i].read(snaps[i]))
+                    snaps[i].result = growattIF::Continue;
+            #endif
+        }
+        port = PAYLOAD_PORT_SLAVES;
+        encode_slaves(modbusSlaves, snaps, NUM_SLAVES, maxPayloadSize(), encoder);
+    } else
+    if (groups & (groups - 1)) {
+        // multiple groups - grouped payload format
+        port = 1;
+        encode_groups(groups, snap.result, snap.data, encoder);
+    } else
+    #endif
+    {
+        port = 1;
+        while (!(groups & PAYLOAD_GROUP(port)))
+            port++;
+        encode_payload(port, snap.result, snap.data, encoder);
+    }
+    TIMING_END(TIMING_ENCODE, tEncode);
+
+    #if defined(RINGLOG_EN)
+        // keep sample for ring log in case the uplink fails
+        this->m_sampleLen = 0;
+        if (snap.result == growattIF::Success) {
+            this->m_sampleLen  = encode_sample(snap.data, this->m_sample);
+            this->m_sampleTime = time(nullptr);
+        }
     #endif
     
     this->m_fBusy = true;
+    this->m_uplinkGroups = groups;
+    this->m_fConfirmed = uplinkPolicy.confirmed();
+    #if defined(RINGLOG_EN)
+        // readings of unconfirmed uplinks are held until a confirmed uplink
+        if (ringLog.held() >= RINGLOG_HOLD)
+            this->m_fConfirmed = true;
+    #endif
 
     // Schedule transmission
+    stats_inc(rtStats.uplinks);
+    TIMING_RESTART(this->m_tSend);
     if (! myLoRaWAN.SendBuffer(
         loraData, encoder.getLength(),
         // this is the completion function:
         [](void *pClientData, bool fSucccess) -> void {
             auto const pThis = (cSensor *)pClientData;
             pThis->m_fBusy = false;
+            TIMING_END(TIMING_TXDONE, pThis->m_tSend);
+            if (!fSucccess)
+                stats_inc(rtStats.uplinkFailed);
+            // unconfirmed uplink: success only means 'transmitted'
+            if (pThis->m_fConfirmed)
+                uplinkPolicy.result(fSucccess, linkMargin());
+            #if defined(PAYLOAD_DELTA)
+                // unconfirmed uplink: keep acknowledged reference,
+                // PAYLOAD_KEYFRAME provides resynchronization
+                if (pThis->m_fConfirmed) {
+                    payload_ack(pThis->m_uplinkGroups, fSucccess);
+                } else if (fSucccess) {
+                    payload_sent(pThis->m_uplinkGroups);
+                }
+            #endif
+            #if defined(RBE_EN)
+                rbe_ack(pThis->m_uplinkGroups, fSucccess);
+            #endif
+            #if defined(RINGLOG_EN)
+                if (!fSucccess) {
+                    // log readings of previous unconfirmed uplinks, too
+                    ringLog.release(false);
+                    pThis->logSample();
+                } else if (pThis->m_fConfirmed) {
+                    // link is up - drop held readings, send stored readings
+                    ringLog.release(true);
+                    pThis->m_fBackfillReq = (ringLog.pending() > 0);
+                } else {
+                    // transmitted, but reception is unknown
+                    ringLog.hold(pThis->m_sampleTime, pThis->m_sample, pThis->m_sampleLen);
+                    pThis->m_sampleLen = 0;
+                }
+            #endif
         },
         (void *)this,
-        /* confirmed */ true,
+        /* confirmed */ this->m_fConfirmed,
         /* port */ port
         )) {
         // sending failed; callback has not been called and will not
         // be called. Reset busy flag.
         this->m_fBusy = false;
+        stats_inc(rtStats.uplinkFailed);
+        // nothing has been sent - delta (PAYLOAD_DELTA) and RBE (RBE_EN)
+        // references are kept
+        #if defined(RINGLOG_EN)
+            logSample();
+        #endif
     }
+    TIMING_END(TIMING_SEND, this->m_tSend);
+
+    #if defined(ENABLE_TIMING)
+        if (++this->m_timingCount >= TIMING_REPORT) {
+            this->m_timingCount = 0;
+            TIMING_REPORT_TABLE();
+        }
+    #endif
 }
@@ -0,0 +1,124 @@
+///////////////////////////////////////////////////////////////////////////////
+// benchAcquisition.cpp
+//
+// Host benchmark: acquisition-to-uplink stages against the simulated inverter
+//
+// Usage: bench_acquisition [-n cycles] [-l latency_ms] [-b baud] [script]...
+//
+// Runs <cycles> acquisitions of all uplink data groups (like the periodic
+// uplink) from the simulated inverter and encodes the grouped payload.
+// The firmware modules are built with ENABLE_TIMING; the summary table of
+// timing.h is printed at the end (the SendBuffer()/TX stages require LMIC
+// and are only measured on the device).
+//
+// The simulated inverter is loaded with the register images in host/data/
+// unless scripts are given.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "growattSlave.h"
+#include "acquisition.h"
+#include "payload.h"
+#include <unistd.h>
+#include <string>
+
+static GrowattSlave slave;
+static ModbusAcquisition acq;
+
+int main(int argc, char *argv[])
+{
+    int cycles  = 10;
+    int latency = 20;
+    int baud    = MODBUS_RATE_RS485;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:l:b:")) != -1) {
+        switch (opt) {
+            case 'n': cycles  = atoi(optarg); break;
+            case 'l': latency = atoi(optarg); break;
+            case 'b': baud    = atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-n cycles] [-l latency_ms] [-b baud] [script]...\n", argv[0]);
+                return 1;
+        }
+    }
+
+    if (!slave.start())
+        return 1;
+    slave.command("latency " + std::to_string(latency));
+    slave.command("baud " + std::to_string(baud));
+    if (optind == argc) {
+        slave.load(HOST_DATA_DIR "/input_registers.txt");
+        slave.load(HOST_DATA_DIR "/holding_registers.txt");
+    }
+    for (int i = optind; i < argc; i++) {
+        if (!slave.load(argv[i]))
+            return 1;
+    }
+    Serial2.setDevice(slave.device());
+    ModbusLink::select();
+
+    #if (PAYLOAD_VERSION == 2)
+        uint8_t groups = PAYLOAD_GROUPS_ALL;
+    #else
+        uint8_t groups = PAYLOAD_GROUP(1);
+    #endif
+    uint8_t failed = 0;
+    for (int i = 0; i < cycles; i++) {
+        acq.start(groups);
+        while (!acq.step())
+            delayMicroseconds(100);
+        if (acq.getResult() != growattIF::Success)
+            failed++;
+
+        Snapshot snap;
+        modbusSnapshot.read(snap);
+        uint8_t buf[64];
+        LoraEncoder encoder(buf);
+        TIMING_BEGIN(tEncode);
+        #if (PAYLOAD_VERSION == 2)
+            encode_groups(groups, snap.result, snap.data, encoder);
+        #else
+            encode_payload(1, snap.result, snap.data, encoder);
+        #endif
+        TIMING_END(TIMING_ENCODE, tEncode);
+    }
+
+    log_i("%d acquisitions (%u failed), latency %d ms, %d baud", cycles, failed, latency, baud);
+    TIMING_REPORT_TABLE();
+    slave.stop();
+    return failed ? 1 : 0;
+}
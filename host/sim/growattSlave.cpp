@@ -0,0 +1,368 @@
+///////////////////////////////////////////////////////////////////////////////
+// growattSlave.cpp
+//
+// Host build: scriptable simulated Growatt inverter (Modbus RTU slave)
+// on a pseudo terminal
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "growattSlave.h"
+#include "ModbusMaster.h"   // modbus_crc16()
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+#define REQ_SIZE            8       // size of supported requests (function codes 3, 4, 6)
+#define FRAME_GAP_MS        5       // partial request is discarded after this silence
+#define MAX_SCRIPT_DEPTH    4       // max. nesting of 'load'
+
+GrowattSlave::GrowattSlave() : m_rng(1)
+{
+}
+
+GrowattSlave::~GrowattSlave()
+{
+    stop();
+}
+
+bool GrowattSlave::start(void)
+{
+    m_master = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((m_master < 0) || (grantpt(m_master) != 0) || (unlockpt(m_master) != 0)) {
+        perror("growattSlave: posix_openpt");
+        return false;
+    }
+    m_device = ptsname(m_master);
+
+    // raw mode; the slave side is kept open, so the master does not see
+    // a hangup while the firmware re-opens its serial interface
+    m_slaveFd = open(m_device.c_str(), O_RDWR | O_NOCTTY);
+    if (m_slaveFd < 0) {
+        perror("growattSlave: open pty");
+        return false;
+    }
+    struct termios tio;
+    tcgetattr(m_slaveFd, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(m_slaveFd, TCSANOW, &tio);
+
+    m_running = true;
+    m_thread  = std::thread(&GrowattSlave::run, this);
+    return true;
+}
+
+void GrowattSlave::stop(void)
+{
+    m_running = false;
+    if (m_thread.joinable())
+        m_thread.join();
+    if (m_slaveFd >= 0)
+        close(m_slaveFd);
+    if (m_master >= 0)
+        close(m_master);
+    m_slaveFd = -1;
+    m_master  = -1;
+}
+
+// Receive requests; frames are delimited by their fixed size and by silence
+void GrowattSlave::run(void)
+{
+    uint8_t buf[REQ_SIZE];
+    size_t  len = 0;
+
+    while (m_running) {
+        struct pollfd p = {m_master, POLLIN, 0};
+        int ready = poll(&p, 1, (len > 0) ? FRAME_GAP_MS : 50);
+        if (ready <= 0) {
+            len = 0;
+            continue;
+        }
+        ssize_t n = read(m_master, &buf[len], REQ_SIZE - len);
+        if (n <= 0)
+            continue;
+        len += n;
+        if (len == REQ_SIZE) {
+            handle(buf);
+            len = 0;
+        }
+    }
+}
+
+void GrowattSlave::handle(const uint8_t *req)
+{
+    uint8_t  adu[5 + 2 * SLAVE_REGS_NUM + 2];
+    size_t   len = 0;
+    size_t   size = 0;
+    uint32_t latency;
+    uint32_t baud;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // scheduled script commands
+        m_count++;
+        for (auto it = m_at.begin(); it != m_at.end(); ) {
+            if (it->first == m_count) {
+                execute(it->second, 0);
+                it = m_at.erase(it);
+            } else {
+                it++;
+            }
+        }
+
+        uint16_t crc = modbus_crc16(req, REQ_SIZE - 2);
+        if ((req[6] != (crc & 0xFF)) || (req[7] != (crc >> 8)))
+            return;
+
+        SlaveRequest r;
+        r.slave    = req[0];
+        r.function = req[1];
+        r.addr     = (req[2] << 8) | req[3];
+        r.count    = (req[4] << 8) | req[5];
+        r.result   = 0;
+
+        std::uniform_int_distribution<uint32_t> permille(0, 999);
+        bool known = std::find(m_slaves.begin(), m_slaves.end(), r.slave) != m_slaves.end();
+        if (!known || m_offline || (permille(m_rng) < m_timeoutErr)) {
+            r.result = SLAVE_NO_RESPONSE;
+            m_log.push_back(r);
+            return;
+        }
+
+        adu[0] = r.slave;
+        adu[1] = r.function;
+        if ((r.function == 0x03) || (r.function == 0x04)) {
+            const uint16_t *regs = (r.function == 0x03) ? m_holding : m_input;
+            if ((r.count == 0) || (r.count > 125) || (r.addr + r.count > SLAVE_REGS_NUM)) {
+                r.result = 0x02;
+            } else {
+                adu[2] = 2 * r.count;
+                for (uint16_t i = 0; i < r.count; i++) {
+                    adu[3 + 2 * i] = regs[r.addr + i] >> 8;
+                    adu[4 + 2 * i] = regs[r.addr + i] & 0xFF;
+                }
+                len = 3 + 2 * r.count;
+            }
+        } else if (r.function == 0x06) {
+            if (r.addr >= SLAVE_REGS_NUM) {
+                r.result = 0x02;
+            } else {
+                m_holding[r.addr] = r.count;
+                memcpy(adu, req, 6);
+                len = 6;
+            }
+        } else {
+            r.result = 0x01;
+        }
+        if (r.result) {
+            // exception response
+            adu[1] |= 0x80;
+            adu[2]  = r.result;
+            len     = 3;
+        }
+
+        crc = modbus_crc16(adu, len);
+        adu[len++] = crc & 0xFF;
+        adu[len++] = crc >> 8;
+        if (permille(m_rng) < m_crcErr) {
+            adu[len - 1] ^= 0xFF;
+            r.result = SLAVE_BAD_CRC;
+        }
+        m_log.push_back(r);
+        size    = len;
+        latency = m_latency;
+        baud    = m_baud;
+    }
+
+    // response latency + transfer time of request and response (11 bits per byte)
+    uint64_t us = latency * 1000ULL + (REQ_SIZE + size) * 11 * 1000000ULL / baud;
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+    respond(adu, size);
+}
+
+void GrowattSlave::respond(const uint8_t *adu, size_t len)
+{
+    size_t done = 0;
+    while (done < len) {
+        ssize_t n = write(m_master, adu + done, len - done);
+        if (n <= 0)
+            return;
+        done += n;
+    }
+}
+
+bool GrowattSlave::command(const std::string &line)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return execute(line, 0);
+}
+
+bool GrowattSlave::load(const std::string &path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return execute("load " + path, 0);
+}
+
+// Parse number (decimal or 0x... hex)
+static bool number(std::istringstream &in, uint32_t &value)
+{
+    std::string tok;
+    if (!(in >> tok))
+        return false;
+    char *end;
+    value = strtoul(tok.c_str(), &end, 0);
+    return *end == '\0';
+}
+
+bool GrowattSlave::execute(const std::string &line, int depth)
+{
+    std::string cmd;
+    std::istringstream in(line.substr(0, line.find('#')));
+    uint32_t v;
+
+    if (!(in >> cmd))
+        return true;
+
+    if (cmd == "slaves") {
+        m_slaves.clear();
+        while (number(in, v))
+            m_slaves.push_back(v);
+        return !m_slaves.empty();
+    }
+    if (cmd == "baud")
+        return number(in, m_baud) && (m_baud > 0);
+    if (cmd == "latency")
+        return number(in, m_latency);
+    if (cmd == "crc")
+        return number(in, m_crcErr);
+    if (cmd == "timeout")
+        return number(in, m_timeoutErr);
+    if (cmd == "offline") {
+        if (!number(in, v))
+            return false;
+        m_offline = v;
+        return true;
+    }
+    if (cmd == "seed") {
+        if (!number(in, v))
+            return false;
+        m_rng.seed(v);
+        return true;
+    }
+    if ((cmd == "input") || (cmd == "holding")) {
+        uint16_t *regs = (cmd == "input") ? m_input : m_holding;
+        uint32_t addr;
+        if (!number(in, addr))
+            return false;
+        size_t n = 0;
+        for (; number(in, v); n++) {
+            if (addr + n >= SLAVE_REGS_NUM)
+                return false;
+            regs[addr + n] = v;
+        }
+        return n > 0;
+    }
+    if (cmd == "input32") {
+        uint32_t addr;
+        if (!number(in, addr) || !number(in, v) || (addr + 2 > SLAVE_REGS_NUM))
+            return false;
+        m_input[addr]     = v >> 16;
+        m_input[addr + 1] = v & 0xFFFF;
+        return true;
+    }
+    if (cmd == "at") {
+        std::string rest;
+        if (!number(in, v) || !std::getline(in, rest))
+            return false;
+        m_at.push_back(std::make_pair(m_count + v, rest));
+        return true;
+    }
+    if (cmd == "load") {
+        std::string path;
+        if (!(in >> path) || (depth >= MAX_SCRIPT_DEPTH))
+            return false;
+        std::ifstream file(path);
+        if (!file) {
+            fprintf(stderr, "growattSlave: cannot open %s\n", path.c_str());
+            return false;
+        }
+        std::string l;
+        int lineNo = 0;
+        bool ok = true;
+        while (std::getline(file, l)) {
+            lineNo++;
+            if (!execute(l, depth + 1)) {
+                fprintf(stderr, "growattSlave: %s:%d: error\n", path.c_str(), lineNo);
+                ok = false;
+            }
+        }
+        return ok;
+    }
+    fprintf(stderr, "growattSlave: unknown command '%s'\n", cmd.c_str());
+    return false;
+}
+
+uint16_t GrowattSlave::input(uint16_t addr)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (addr < SLAVE_REGS_NUM) ? m_input[addr] : 0;
+}
+
+uint16_t GrowattSlave::holding(uint16_t addr)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (addr < SLAVE_REGS_NUM) ? m_holding[addr] : 0;
+}
+
+std::vector<SlaveRequest> GrowattSlave::requests(void)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_log;
+}
+
+void GrowattSlave::clearRequests(void)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_log.clear();
+}
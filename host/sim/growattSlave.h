@@ -0,0 +1,170 @@
+///////////////////////////////////////////////////////////////////////////////
+// growattSlave.h
+//
+// Host build: scriptable simulated Growatt inverter (Modbus RTU slave)
+// on a pseudo terminal
+//
+// The firmware under test opens the pty slave device (see device()) as its
+// Modbus serial interface (HardwareSerial::setDevice()). Requests are
+// answered by a thread with the configured latency and transfer time;
+// CRC errors, timeouts and offline periods can be injected.
+//
+// Script commands (one per line, '#' starts a comment; numbers may be
+// given as 0x... hex values):
+//
+// slaves <id>...            responding slave IDs (default: 1)
+// baud <rate>               data rate for transfer time (default: 9600)
+// latency <ms>              response latency (default: 0)
+// crc <per mille>           responses with CRC error
+// timeout <per mille>       requests without response
+// offline <0|1>             no response at all (inverter without power)
+// seed <n>                  seed of error injection
+// input <addr> <v>...       set input registers starting at <addr>
+// holding <addr> <v>...     set holding registers starting at <addr>
+// input32 <addr> <v>        set 32-bit input register (high word first)
+// load <file>               execute script file (e.g. register dump)
+// at <n> <command>          execute <command> before the <n>th request from now
+//
+// Register dumps (host/data/) use the same syntax.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef GROWATT_SLAVE_H
+#define GROWATT_SLAVE_H
+
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define SLAVE_REGS_NUM      128     // size of simulated register images
+
+/// Request received by the simulated slave
+struct SlaveRequest {
+    uint8_t  slave;         //!< slave ID
+    uint8_t  function;      //!< function code
+    uint16_t addr;          //!< register address
+    uint16_t count;         //!< no. of registers (write: value)
+    uint8_t  result;        //!< 0: answered, else injected error / exception code
+};
+
+/// Result of injected errors (see SlaveRequest::result)
+#define SLAVE_NO_RESPONSE   0xE2    // no response (timeout, offline, other slave ID)
+#define SLAVE_BAD_CRC       0xE3    // response with invalid CRC
+
+/*!
+ * \class GrowattSlave
+ *
+ * \brief Simulated Growatt inverter(s) on a pty
+ */
+class GrowattSlave {
+public:
+    GrowattSlave();
+    ~GrowattSlave();
+
+    /*!
+     * \brief Create pty and start answering requests
+     *
+     * \returns true if successful
+     */
+    bool start(void);
+
+    /// Stop answering requests and close pty
+    void stop(void);
+
+    /// pty slave device - serial interface of the firmware under test
+    const char *device(void) const {
+        return m_device.c_str();
+    }
+
+    /*!
+     * \brief Execute script command (see file header)
+     *
+     * \returns false on syntax error
+     */
+    bool command(const std::string &line);
+
+    /*!
+     * \brief Execute script file
+     *
+     * \returns false if the file cannot be read or contains errors
+     */
+    bool load(const std::string &path);
+
+    /// Input register (addresses >= SLAVE_REGS_NUM: 0)
+    uint16_t input(uint16_t addr);
+
+    /// Holding register (addresses >= SLAVE_REGS_NUM: 0)
+    uint16_t holding(uint16_t addr);
+
+    /// Requests received since start or clearRequests()
+    std::vector<SlaveRequest> requests(void);
+
+    /// Clear request log
+    void clearRequests(void);
+
+private:
+    void run(void);
+    void handle(const uint8_t *req);
+    bool execute(const std::string &line, int depth);
+    void respond(const uint8_t *adu, size_t len);
+
+    std::mutex                m_mutex;
+    std::thread               m_thread;
+    std::atomic<bool>         m_running{false};
+    int                       m_master = -1;        //!< pty master
+    int                       m_slaveFd = -1;       //!< pty slave (kept open)
+    std::string               m_device;
+    std::mt19937              m_rng;
+
+    uint16_t                  m_input[SLAVE_REGS_NUM] = {};
+    uint16_t                  m_holding[SLAVE_REGS_NUM] = {};
+    std::vector<uint8_t>      m_slaves{1};
+    uint32_t                  m_baud = 9600;
+    uint32_t                  m_latency = 0;
+    uint32_t                  m_crcErr = 0;
+    uint32_t                  m_timeoutErr = 0;
+    bool                      m_offline = false;
+
+    uint32_t                  m_count = 0;          //!< no. of requests received
+    std::vector<std::pair<uint32_t, std::string>> m_at;     //!< pending 'at' commands
+    std::vector<SlaveRequest> m_log;
+};
+
+#endif
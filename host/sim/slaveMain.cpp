@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////
+// slaveMain.cpp
+//
+// Host build: simulated Growatt inverter as stand-alone program
+//
+// Usage: growatt_slave [script]...
+//
+// Prints the pty device to be used as Modbus serial interface, executes
+// the given script files and then reads script commands from stdin
+// (see growattSlave.h); runs until SIGINT or SIGTERM.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "growattSlave.h"
+#include <signal.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <poll.h>
+#include <iostream>
+#include <string>
+
+static volatile sig_atomic_t stopReq = 0;
+
+static void onSignal(int)
+{
+    stopReq = 1;
+}
+
+int main(int argc, char *argv[])
+{
+    GrowattSlave slave;
+
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    if (!slave.start())
+        return 1;
+    for (int i = 1; i < argc; i++) {
+        if (!slave.load(argv[i]))
+            return 1;
+    }
+    printf("%s\n", slave.device());
+    fflush(stdout);
+
+    bool input = true;
+    std::string line;
+    while (!stopReq) {
+        if (!input) {
+            pause();
+            continue;
+        }
+        struct pollfd p = {STDIN_FILENO, POLLIN, 0};
+        if (poll(&p, 1, 100) <= 0)
+            continue;
+        if (!std::getline(std::cin, line)) {
+            // keep serving requests without command input
+            input = false;
+            continue;
+        }
+        if (!slave.command(line))
+            fprintf(stderr, "error: %s\n", line.c_str());
+    }
+    slave.stop();
+    return 0;
+}
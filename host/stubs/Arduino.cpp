@@ -0,0 +1,289 @@
+///////////////////////////////////////////////////////////////////////////////
+// Arduino.cpp
+//
+// Host build: minimal Arduino/ESP32/FreeRTOS API (see Arduino.h)
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Arduino.h"
+#include <stdarg.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <poll.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <thread>
+
+HardwareSerial Serial(0);
+HardwareSerial Serial1(1);
+HardwareSerial Serial2(2);
+EspClass ESP;
+
+static const auto tStart = std::chrono::steady_clock::now();
+
+uint32_t millis(void)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - tStart).count();
+}
+
+uint32_t micros(void)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - tStart).count();
+}
+
+void delay(uint32_t ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(uint32_t us)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void pinMode(int, int) {}
+void digitalWrite(int, int) {}
+int digitalRead(int) { return HIGH; }
+
+static std::mt19937 rng(1);
+
+long random(long max)
+{
+    return (max > 0) ? (long)(rng() % (unsigned long)max) : 0;
+}
+
+long random(long min, long max)
+{
+    return (max > min) ? min + random(max - min) : min;
+}
+
+void randomSeed(unsigned long seed)
+{
+    rng.seed(seed);
+}
+
+size_t Stream::write(const uint8_t *buf, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        write(buf[i]);
+    return n;
+}
+
+//
+// HardwareSerial
+//
+void HardwareSerial::setDevice(const char *path)
+{
+    m_device = path ? path : "";
+}
+
+void HardwareSerial::begin(unsigned long, uint32_t, int8_t, int8_t)
+{
+    // baud rate is not applied - transfer time is simulated by the slave
+    end();
+    if (m_device.empty())
+        return;
+
+    m_fd = open(m_device.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (m_fd < 0) {
+        log_e("Serial%d: cannot open %s", m_num, m_device.c_str());
+        return;
+    }
+    struct termios tio;
+    if (tcgetattr(m_fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        tcsetattr(m_fd, TCSANOW, &tio);
+    }
+}
+
+void HardwareSerial::end(void)
+{
+    if (m_fd >= 0)
+        close(m_fd);
+    m_fd = -1;
+}
+
+int HardwareSerial::available(void)
+{
+    if (m_fd < 0)
+        return 0;
+    struct pollfd p = {m_fd, POLLIN, 0};
+    return (poll(&p, 1, 0) > 0) && (p.revents & POLLIN) ? 1 : 0;
+}
+
+int HardwareSerial::read(void)
+{
+    uint8_t c;
+    return (read(&c, 1) == 1) ? c : -1;
+}
+
+size_t HardwareSerial::read(uint8_t *buf, size_t n)
+{
+    if (m_fd < 0)
+        return 0;
+    ssize_t len = ::read(m_fd, buf, n);
+    return (len > 0) ? len : 0;
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t *buf, size_t n)
+{
+    if (m_fd >= 0) {
+        size_t done = 0;
+        while (done < n) {
+            ssize_t len = ::write(m_fd, buf + done, n - done);
+            if (len < 0)
+                break;
+            done += len;
+        }
+        return done;
+    }
+    if (m_num == 0)
+        return fwrite(buf, 1, n, stdout);
+    return n;
+}
+
+void HardwareSerial::flush(void)
+{
+    if (m_fd >= 0)
+        tcdrain(m_fd);
+    else if (m_num == 0)
+        fflush(stdout);
+}
+
+size_t HardwareSerial::print(unsigned long v, int base)
+{
+    char buf[24];
+    snprintf(buf, sizeof(buf), (base == HEX) ? "%lX" : "%lu", v);
+    return print(buf);
+}
+
+size_t HardwareSerial::printf(const char *fmt, ...)
+{
+    char buf[256];
+    va_list args;
+    va_start(args, fmt);
+    int len = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    return (len > 0) ? print(buf) : 0;
+}
+
+//
+// FreeRTOS
+//
+TickType_t xTaskGetTickCount(void)
+{
+    return millis();
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    delay(ticks);
+}
+
+void vTaskDelayUntil(TickType_t *prev, TickType_t increment)
+{
+    *prev += increment;
+    int32_t remaining = (int32_t)(*prev - millis());
+    if (remaining > 0)
+        delay(remaining);
+}
+
+BaseType_t xTaskCreatePinnedToCore(void (*fn)(void *), const char *, uint32_t,
+                                   void *param, int, TaskHandle_t *handle, int)
+{
+    std::thread(fn, param).detach();
+    if (handle)
+        *handle = nullptr;
+    return pdPASS;
+}
+
+struct HostSemaphore {
+    std::mutex              mutex;
+    std::condition_variable cond;
+    bool                    given = false;
+};
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return new HostSemaphore;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+    auto s = static_cast<HostSemaphore *>(sem);
+    std::unique_lock<std::mutex> lock(s->mutex);
+    auto ready = [s] { return s->given; };
+    if (ticks == portMAX_DELAY) {
+        s->cond.wait(lock, ready);
+    } else if (!s->cond.wait_for(lock, std::chrono::milliseconds(ticks), ready)) {
+        return pdFALSE;
+    }
+    s->given = false;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    auto s = static_cast<HostSemaphore *>(sem);
+    {
+        std::lock_guard<std::mutex> lock(s->mutex);
+        s->given = true;
+    }
+    s->cond.notify_one();
+    return pdTRUE;
+}
+
+static std::recursive_mutex criticalMutex;
+
+void host_enter_critical(void)
+{
+    criticalMutex.lock();
+}
+
+void host_exit_critical(void)
+{
+    criticalMutex.unlock();
+}
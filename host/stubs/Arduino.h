@@ -0,0 +1,249 @@
+///////////////////////////////////////////////////////////////////////////////
+// Arduino.h
+//
+// Host build: minimal Arduino/ESP32/FreeRTOS API for compiling the modules
+// in src/ natively on Linux
+//
+// - millis()/micros()/delay() use the monotonic system clock
+// - HardwareSerial is backed by a file descriptor (e.g. a pty, see
+//   HardwareSerial::setDevice()); Serial writes to stdout by default
+// - portMUX critical sections are mapped to one global recursive mutex
+// - tasks are std::threads
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <string>
+#include <functional>
+
+// Logging (ESP32 Arduino core)
+#define ARDUHAL_LOG_LEVEL_NONE      0
+#define ARDUHAL_LOG_LEVEL_ERROR     1
+#define ARDUHAL_LOG_LEVEL_WARN      2
+#define ARDUHAL_LOG_LEVEL_INFO      3
+#define ARDUHAL_LOG_LEVEL_DEBUG     4
+#define ARDUHAL_LOG_LEVEL_VERBOSE   5
+#ifndef CORE_DEBUG_LEVEL
+    #define CORE_DEBUG_LEVEL        ARDUHAL_LOG_LEVEL_INFO
+#endif
+
+#define HOST_LOG(l, fmt, ...)   printf("[%6u][" l "] " fmt "\n", millis(), ##__VA_ARGS__)
+#if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_ERROR
+    #define log_e(fmt, ...)     HOST_LOG("E", fmt, ##__VA_ARGS__)
+#else
+    #define log_e(fmt, ...)
+#endif
+#if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_WARN
+    #define log_w(fmt, ...)     HOST_LOG("W", fmt, ##__VA_ARGS__)
+#else
+    #define log_w(fmt, ...)
+#endif
+#if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_INFO
+    #define log_i(fmt, ...)     HOST_LOG("I", fmt, ##__VA_ARGS__)
+#else
+    #define log_i(fmt, ...)
+#endif
+#if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_DEBUG
+    #define log_d(fmt, ...)     HOST_LOG("D", fmt, ##__VA_ARGS__)
+#else
+    #define log_d(fmt, ...)
+#endif
+#if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_VERBOSE
+    #define log_v(fmt, ...)     HOST_LOG("V", fmt, ##__VA_ARGS__)
+#else
+    #define log_v(fmt, ...)
+#endif
+
+// Attributes
+#define RTC_DATA_ATTR
+#define IRAM_ATTR
+#define F(x)            x
+
+// Digital I/O (no-op)
+#define INPUT           0x01
+#define OUTPUT          0x03
+#define INPUT_PULLUP    0x05
+#define LOW             0
+#define HIGH            1
+#define LED_BUILTIN     2
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int value);
+int digitalRead(int pin);
+
+// Time
+uint32_t millis(void);
+uint32_t micros(void);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+// Random numbers (deterministic, see randomSeed())
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+template <class T> inline T min(T a, T b) { return (a < b) ? a : b; }
+template <class T> inline T max(T a, T b) { return (a > b) ? a : b; }
+#define constrain(x, lo, hi)    ((x) < (lo) ? (lo) : ((x) > (hi) ? (hi) : (x)))
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define DEC 10
+#define HEX 16
+
+/// Arduino String (subset)
+class String : public std::string {
+public:
+    String() {}
+    String(const char *s) : std::string(s) {}
+    String(const std::string &s) : std::string(s) {}
+    String(int v) : std::string(std::to_string(v)) {}
+    String(unsigned v) : std::string(std::to_string(v)) {}
+    String &operator=(const char *s) { assign(s); return *this; }
+    String &operator=(uint8_t v) { assign(std::to_string(v)); return *this; }
+    bool operator==(const char *s) const { return compare(s) == 0; }
+};
+
+/// Arduino Stream (subset)
+class Stream {
+public:
+    virtual ~Stream() {}
+    virtual int available(void) { return 0; }
+    virtual int read(void) { return -1; }
+    virtual size_t write(uint8_t) { return 1; }
+    virtual size_t write(const uint8_t *buf, size_t n);
+    virtual void flush(void) {}
+};
+
+#define SERIAL_8N1      0x800001c
+#define UART_MODE_RS485_HALF_DUPLEX 1
+
+/*!
+ * \class HardwareSerial
+ *
+ * \brief Serial interface backed by a file descriptor
+ *
+ * Without a device (see setDevice()), Serial writes to stdout and all
+ * other interfaces discard output; nothing is received.
+ */
+class HardwareSerial : public Stream {
+public:
+    HardwareSerial(int num) : m_num(num) {}
+
+    /// Host build only: use device (e.g. pty slave) with next begin()
+    void setDevice(const char *path);
+
+    void begin(unsigned long baud, uint32_t config = SERIAL_8N1, int8_t rxPin = -1, int8_t txPin = -1);
+    void end(void);
+    int available(void) override;
+    int read(void) override;
+    size_t read(uint8_t *buf, size_t n);
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buf, size_t n) override;
+    void flush(void) override;
+
+    size_t print(const char *s)             { return write((const uint8_t *)s, strlen(s)); }
+    size_t print(const String &s)           { return print(s.c_str()); }
+    size_t print(char c)                    { return write((uint8_t)c); }
+    size_t print(unsigned long v, int base = DEC);
+    size_t println(void)                    { return print("\n"); }
+    size_t println(const char *s)           { return print(s) + println(); }
+    size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+    void setDebugOutput(bool) {}
+    operator bool() const { return true; }
+
+    // ESP32 UART extensions (no-op)
+    bool setPins(int8_t, int8_t, int8_t = -1, int8_t = -1) { return true; }
+    bool setMode(int) { return true; }
+    bool setRxTimeout(uint8_t) { return true; }
+    void onReceive(std::function<void(void)>, bool = false) {}
+
+private:
+    int         m_num;
+    int         m_fd = -1;
+    std::string m_device;
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+extern HardwareSerial Serial2;
+
+/// ESP (subset)
+class EspClass {
+public:
+    void deepSleep(uint64_t) {}
+    void restart(void) {}
+};
+extern EspClass ESP;
+
+// FreeRTOS (subset) - tick period is 1 ms
+typedef uint32_t TickType_t;
+typedef int      BaseType_t;
+typedef void    *TaskHandle_t;
+typedef void    *SemaphoreHandle_t;
+#define pdTRUE              1
+#define pdFALSE             0
+#define pdPASS              1
+#define portMAX_DELAY       0xFFFFFFFFUL
+#define pdMS_TO_TICKS(ms)   ((TickType_t)(ms))
+
+TickType_t xTaskGetTickCount(void);
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t *prev, TickType_t increment);
+BaseType_t xTaskCreatePinnedToCore(void (*fn)(void *), const char *name, uint32_t stack,
+                                   void *param, int prio, TaskHandle_t *handle, int core);
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+
+// Critical sections - one global lock
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED    0
+void host_enter_critical(void);
+void host_exit_critical(void);
+#define portENTER_CRITICAL(mux)         ((void)(mux), host_enter_critical())
+#define portEXIT_CRITICAL(mux)          ((void)(mux), host_exit_critical())
+
+#endif
@@ -0,0 +1,94 @@
+///////////////////////////////////////////////////////////////////////////////
+// LoraMessage.h
+//
+// Host build: LoraEncoder of the LoRa Serialization library
+// (https://github.com/thesolarnomad/lora-serialization) - subset used by
+// the payload encoders, same byte order as the original
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef HOST_LORAMESSAGE_H
+#define HOST_LORAMESSAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/*!
+ * \class LoraEncoder
+ *
+ * \brief Serialize values into a byte buffer (little endian)
+ */
+class LoraEncoder {
+public:
+    LoraEncoder(uint8_t *buffer) : m_buf(buffer) {}
+
+    void writeUint8(uint8_t v)      { m_buf[m_len++] = v; }
+    void writeUint16(uint16_t v)    { writeInt(v, 2); }
+    void writeUint32(uint32_t v)    { writeInt(v, 4); }
+    void writeUnixtime(uint32_t v)  { writeInt(v, 4); }
+    void writeHumidity(float h)     { writeInt((uint16_t)(h * 100), 2); }
+
+    /// Temperature: int16 * 100, big endian (as the original library)
+    void writeTemperature(float t) {
+        int16_t v = (int16_t)(t * 100);
+        m_buf[m_len++] = (uint16_t)v >> 8;
+        m_buf[m_len++] = v & 0xFF;
+    }
+
+    void writeRawFloat(float f) {
+        memcpy(&m_buf[m_len], &f, 4);
+        m_len += 4;
+    }
+
+    void writeBitmap(bool a, bool b, bool c, bool d, bool e, bool f, bool g, bool h) {
+        m_buf[m_len++] = (a << 7) | (b << 6) | (c << 5) | (d << 4) | (e << 3) | (f << 2) | (g << 1) | h;
+    }
+
+    size_t getLength(void) { return m_len; }
+
+private:
+    void writeInt(uint32_t v, uint8_t n) {
+        for (uint8_t i = 0; i < n; i++)
+            m_buf[m_len++] = (v >> (8 * i)) & 0xFF;
+    }
+
+    uint8_t *m_buf;
+    size_t   m_len = 0;
+};
+
+#endif
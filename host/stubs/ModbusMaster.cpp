@@ -0,0 +1,148 @@
+///////////////////////////////////////////////////////////////////////////////
+// ModbusMaster.cpp
+//
+// Host build: Modbus RTU master (see ModbusMaster.h)
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ModbusMaster.h"
+
+#define FC_READ_HOLDING     0x03
+#define FC_READ_INPUT       0x04
+#define FC_WRITE_SINGLE     0x06
+
+uint16_t modbus_crc16(const uint8_t *buf, size_t len)
+{
+    uint16_t crc = 0xFFFF;
+
+    for (size_t i = 0; i < len; i++) {
+        crc ^= buf[i];
+        for (int b = 0; b < 8; b++)
+            crc = (crc & 1) ? (crc >> 1) ^ 0xA001 : (crc >> 1);
+    }
+    return crc;
+}
+
+uint8_t ModbusMaster::readInputRegisters(uint16_t addr, uint16_t count)
+{
+    return transaction(FC_READ_INPUT, addr, count);
+}
+
+uint8_t ModbusMaster::readHoldingRegisters(uint16_t addr, uint16_t count)
+{
+    return transaction(FC_READ_HOLDING, addr, count);
+}
+
+uint8_t ModbusMaster::writeSingleRegister(uint16_t addr, uint16_t value)
+{
+    return transaction(FC_WRITE_SINGLE, addr, value);
+}
+
+uint8_t ModbusMaster::transaction(uint8_t function, uint16_t addr, uint16_t value)
+{
+    uint8_t adu[256];
+
+    if (!m_serial)
+        return ku8MBResponseTimedOut;
+
+    // request
+    adu[0] = m_slave;
+    adu[1] = function;
+    adu[2] = addr >> 8;
+    adu[3] = addr & 0xFF;
+    adu[4] = value >> 8;
+    adu[5] = value & 0xFF;
+    uint16_t crc = modbus_crc16(adu, 6);
+    adu[6] = crc & 0xFF;
+    adu[7] = crc >> 8;
+
+    // discard stale data (e.g. late response of previous request)
+    while (m_serial->available())
+        m_serial->read();
+
+    if (m_preTransmission)
+        m_preTransmission();
+    m_serial->write(adu, 8);
+    m_serial->flush();
+    if (m_postTransmission)
+        m_postTransmission();
+
+    // response - length is known after the third byte
+    size_t   len = 0;
+    size_t   expected = 5;
+    uint32_t tStart = millis();
+    while (len < expected) {
+        if (millis() - tStart >= ku16MBResponseTimeout)
+            return ku8MBResponseTimedOut;
+        if (!m_serial->available()) {
+            delayMicroseconds(100);
+            continue;
+        }
+        int c = m_serial->read();
+        if (c < 0)
+            continue;
+        adu[len++] = c;
+
+        if (len == 1 && adu[0] != m_slave)
+            return ku8MBInvalidSlaveID;
+        if (len == 2 && (adu[1] & 0x7F) != function)
+            return ku8MBInvalidFunction;
+        if (len == 3) {
+            if (adu[1] & 0x80) {
+                expected = 5;
+            } else if (function == FC_WRITE_SINGLE) {
+                expected = 8;
+            } else {
+                expected = 5 + adu[2];
+            }
+        }
+    }
+
+    crc = modbus_crc16(adu, len - 2);
+    if ((adu[len - 2] != (crc & 0xFF)) || (adu[len - 1] != (crc >> 8)))
+        return ku8MBInvalidCRC;
+
+    if (adu[1] & 0x80)
+        return adu[2];
+
+    if (function == FC_WRITE_SINGLE) {
+        m_response[0] = (adu[4] << 8) | adu[5];
+    } else {
+        for (uint8_t i = 0; (i < adu[2] / 2) && (i < ku8MaxBufferSize); i++)
+            m_response[i] = (adu[3 + 2 * i] << 8) | adu[4 + 2 * i];
+    }
+    return ku8MBSuccess;
+}
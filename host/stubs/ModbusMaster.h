@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////////////////////////
+// ModbusMaster.h
+//
+// Host build: Modbus RTU master with the interface of the ModbusMaster
+// library (https://github.com/4-20ma/ModbusMaster) - subset used by
+// growattInterface
+//
+// Requests are sent via the Stream passed to begin() (e.g. HardwareSerial
+// connected to the simulated slave, see host/sim/growattSlave.h);
+// responses are checked for slave ID, function code and CRC like in the
+// original library.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef HOST_MODBUSMASTER_H
+#define HOST_MODBUSMASTER_H
+
+#include "Arduino.h"
+
+/*!
+ * \brief Modbus CRC16 (polynomial 0xA001, initial value 0xFFFF)
+ *
+ * \param buf   data
+ * \param len   length in bytes
+ */
+uint16_t modbus_crc16(const uint8_t *buf, size_t len);
+
+/*!
+ * \class ModbusMaster
+ *
+ * \brief Modbus RTU master (blocking, like the original library)
+ */
+class ModbusMaster {
+public:
+    // Modbus exception codes
+    static const uint8_t ku8MBIllegalFunction       = 0x01;
+    static const uint8_t ku8MBIllegalDataAddress    = 0x02;
+    static const uint8_t ku8MBIllegalDataValue      = 0x03;
+    static const uint8_t ku8MBSlaveDeviceFailure    = 0x04;
+
+    // ModbusMaster error codes
+    static const uint8_t ku8MBSuccess               = 0x00;
+    static const uint8_t ku8MBInvalidSlaveID        = 0xE0;
+    static const uint8_t ku8MBInvalidFunction       = 0xE1;
+    static const uint8_t ku8MBResponseTimedOut      = 0xE2;
+    static const uint8_t ku8MBInvalidCRC            = 0xE3;
+
+    static const uint8_t  ku8MaxBufferSize          = 64;
+    static const uint16_t ku16MBResponseTimeout     = 2000;     // [ms]
+
+    ModbusMaster() {}
+
+    void begin(uint8_t slave, Stream &serial) {
+        m_slave  = slave;
+        m_serial = &serial;
+    }
+    void preTransmission(void (*fn)()) {
+        m_preTransmission = fn;
+    }
+    void postTransmission(void (*fn)()) {
+        m_postTransmission = fn;
+    }
+
+    uint8_t readInputRegisters(uint16_t addr, uint16_t count);
+    uint8_t readHoldingRegisters(uint16_t addr, uint16_t count);
+    uint8_t writeSingleRegister(uint16_t addr, uint16_t value);
+
+    uint16_t getResponseBuffer(uint8_t index) {
+        return (index < ku8MaxBufferSize) ? m_response[index] : 0xFFFF;
+    }
+    void clearResponseBuffer(void) {
+        memset(m_response, 0, sizeof(m_response));
+    }
+
+private:
+    uint8_t transaction(uint8_t function, uint16_t addr, uint16_t value);
+
+    Stream  *m_serial = nullptr;
+    uint8_t  m_slave = 1;
+    uint16_t m_response[ku8MaxBufferSize] = {};
+    void   (*m_preTransmission)() = nullptr;
+    void   (*m_postTransmission)() = nullptr;
+};
+
+#endif
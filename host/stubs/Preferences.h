@@ -0,0 +1,113 @@
+///////////////////////////////////////////////////////////////////////////////
+// Preferences.h
+//
+// Host build: ESP32 Preferences (NVS) kept in memory
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include "Arduino.h"
+#include <map>
+#include <vector>
+
+/*!
+ * \class Preferences
+ *
+ * \brief Key/value store per namespace (contents are lost at exit)
+ */
+class Preferences {
+public:
+    bool begin(const char *name, bool readOnly = false) {
+        m_ns = name;
+        return true;
+    }
+    void end(void) {}
+    bool clear(void)                { store()[m_ns].clear(); return true; }
+    bool remove(const char *key)    { return store()[m_ns].erase(key) > 0; }
+    bool isKey(const char *key)     { return store()[m_ns].count(key) > 0; }
+
+    size_t putBytes(const char *key, const void *value, size_t len) {
+        const uint8_t *p = static_cast<const uint8_t *>(value);
+        store()[m_ns][key].assign(p, p + len);
+        return len;
+    }
+    size_t getBytes(const char *key, void *buf, size_t maxLen) {
+        if (!isKey(key))
+            return 0;
+        std::vector<uint8_t> &v = store()[m_ns][key];
+        size_t len = (v.size() < maxLen) ? v.size() : maxLen;
+        memcpy(buf, v.data(), len);
+        return len;
+    }
+    size_t getBytesLength(const char *key) {
+        return isKey(key) ? store()[m_ns][key].size() : 0;
+    }
+
+    size_t   putUChar(const char *key, uint8_t v)           { return put(key, v); }
+    uint8_t  getUChar(const char *key, uint8_t def = 0)     { return get(key, def); }
+    size_t   putChar(const char *key, int8_t v)             { return put(key, v); }
+    int8_t   getChar(const char *key, int8_t def = 0)       { return get(key, def); }
+    size_t   putUShort(const char *key, uint16_t v)         { return put(key, v); }
+    uint16_t getUShort(const char *key, uint16_t def = 0)   { return get(key, def); }
+    size_t   putShort(const char *key, int16_t v)           { return put(key, v); }
+    int16_t  getShort(const char *key, int16_t def = 0)     { return get(key, def); }
+    size_t   putULong(const char *key, uint32_t v)          { return put(key, v); }
+    uint32_t getULong(const char *key, uint32_t def = 0)    { return get(key, def); }
+    size_t   putBool(const char *key, bool v)               { return put(key, v); }
+    bool     getBool(const char *key, bool def = false)     { return get(key, def); }
+
+private:
+    typedef std::map<std::string, std::map<std::string, std::vector<uint8_t>>> Store;
+
+    static Store &store(void) {
+        static Store s;
+        return s;
+    }
+    template <class T> size_t put(const char *key, T v) {
+        return putBytes(key, &v, sizeof(v));
+    }
+    template <class T> T get(const char *key, T def) {
+        T v;
+        return (getBytes(key, &v, sizeof(v)) == sizeof(v)) ? v : def;
+    }
+
+    std::string m_ns;
+};
+
+#endif
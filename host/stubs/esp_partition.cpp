@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////
+// esp_partition.cpp
+//
+// Host build: ESP-IDF partition API with flash emulated in memory
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Partitions as in partitions.csv, added host_partition_remove()
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "esp_partition.h"
+#include <string.h>
+#include <vector>
+
+#define HOST_SECTOR_SIZE    4096
+
+// Partition table of the host build (data partitions of partitions.csv)
+static const esp_partition_t host_partitions[] = {
+    { ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_NVS,    0x9000,   0x5000,   "nvs" },
+    { ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, 0x290000, 0x150000, "spiffs" },
+    { ESP_PARTITION_TYPE_DATA, (esp_partition_subtype_t)0x40,     0x3E0000, 0x10000,  "ringlog" }
+};
+
+#define NUM_PARTITIONS  (sizeof(host_partitions) / sizeof(esp_partition_t))
+
+static bool removed[NUM_PARTITIONS];
+
+static std::vector<uint8_t> &flash(const esp_partition_t *part)
+{
+    static std::vector<uint8_t> mem[NUM_PARTITIONS];
+    std::vector<uint8_t> &m = mem[part - host_partitions];
+    if (m.empty())
+        m.assign(part->size, 0xFF);
+    return m;
+}
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char *label)
+{
+    for (size_t i = 0; i < NUM_PARTITIONS; i++) {
+        const esp_partition_t &p = host_partitions[i];
+        if (!removed[i] && (p.type == type) &&
+            ((subtype == ESP_PARTITION_SUBTYPE_ANY) || (p.subtype == subtype)) &&
+            ((label == nullptr) || (strcmp(label, p.label) == 0)))
+            return &p;
+    }
+    return nullptr;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t *part, size_t offset, void *dst, size_t size)
+{
+    if (!part || (offset + size > part->size))
+        return ESP_ERR_INVALID_SIZE;
+    memcpy(dst, &flash(part)[offset], size);
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_write(const esp_partition_t *part, size_t offset, const void *src, size_t size)
+{
+    if (!part || (offset + size > part->size))
+        return ESP_ERR_INVALID_SIZE;
+    const uint8_t *s = static_cast<const uint8_t *>(src);
+    std::vector<uint8_t> &m = flash(part);
+    for (size_t i = 0; i < size; i++)
+        m[offset + i] &= s[i];
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t *part, size_t offset, size_t size)
+{
+    if (!part || (offset + size > part->size))
+        return ESP_ERR_INVALID_SIZE;
+    if ((offset % HOST_SECTOR_SIZE) || (size % HOST_SECTOR_SIZE))
+        return ESP_ERR_INVALID_ARG;
+    memset(&flash(part)[offset], 0xFF, size);
+    return ESP_OK;
+}
+
+void host_partition_remove(const char *label)
+{
+    for (size_t i = 0; i < NUM_PARTITIONS; i++) {
+        if (strcmp(label, host_partitions[i].label) == 0)
+            removed[i] = true;
+    }
+}
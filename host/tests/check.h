@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////////////////////////////////
+// check.h
+//
+// Host tests: minimal check macros (no test framework dependency)
+//
+// CHECK(cond) and CHECK_NEAR(a, b, eps) report failures and continue;
+// main() returns check_result() (0: all checks passed).
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef HOST_CHECK_H
+#define HOST_CHECK_H
+
+#include <stdio.h>
+#include <math.h>
+
+static int check_failed = 0;
+static int check_count  = 0;
+
+#define CHECK(cond) do { \
+    check_count++; \
+    if (!(cond)) { \
+        check_failed++; \
+        fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+    } \
+} while (0)
+
+#define CHECK_EQ(a, b) do { \
+    check_count++; \
+    long long va_ = (long long)(a); \
+    long long vb_ = (long long)(b); \
+    if (va_ != vb_) { \
+        check_failed++; \
+        fprintf(stderr, "%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n", \
+                __FILE__, __LINE__, #a, #b, va_, vb_); \
+    } \
+} while (0)
+
+#define CHECK_NEAR(a, b, eps) do { \
+    check_count++; \
+    double va_ = (a); \
+    double vb_ = (b); \
+    if (fabs(va_ - vb_) > (eps)) { \
+        check_failed++; \
+        fprintf(stderr, "%s:%d: CHECK_NEAR(%s, %s) failed: %g != %g\n", \
+                __FILE__, __LINE__, #a, #b, va_, vb_); \
+    } \
+} while (0)
+
+/// Print summary; returns process exit code
+static inline int check_result(void)
+{
+    printf("%d checks, %d failed\n", check_count, check_failed);
+    return check_failed ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,187 @@
+///////////////////////////////////////////////////////////////////////////////
+// test_acquisition.cpp
+//
+// Host test: acquisition state machine, payload encoding and uplink
+// scheduler state against the simulated inverter - normal operation,
+// retry after CRC error, failed grid capture poll, settings retry interval
+// and inverter offline
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "check.h"
+#include "growattSlave.h"
+#include "acquisition.h"
+#include "payload.h"
+#include "uplinkScheduler.h"
+#include "settingsCache.h"
+
+static GrowattSlave slave;
+static ModbusAcquisition acq;
+
+// Run acquisition until completed; returns result
+static uint8_t acquire(uint8_t groups)
+{
+    acq.start(groups);
+    while (!acq.step())
+        delay(1);
+    return acq.getResult();
+}
+
+// Failed settings read - no holding register reads until SETTINGS_RETRY
+// has expired, even if no valid settings are cached
+static void testSettingsRetry(void)
+{
+    modbus_holding_registers data = {};
+
+    CHECK(settingsCache.isDue());
+    settingsCache.update(ModbusTransport::ku8MBIllegalDataAddress, data);
+    CHECK(!settingsCache.isDue());
+
+    slave.clearRequests();
+    CHECK_EQ(acquire(PAYLOAD_GROUPS_ALL), growattIF::Success);
+    size_t holdingReads = 0;
+    for (const SlaveRequest &r : slave.requests()) {
+        if (r.function == 0x03)
+            holdingReads++;
+    }
+    CHECK_EQ(holdingReads, 0);
+
+    // refresh is due again after invalidate()
+    settingsCache.invalidate();
+    CHECK(settingsCache.isDue());
+}
+
+static void testNormal(void)
+{
+    Snapshot snap;
+
+    slave.command("input 0 1");                 // status: normal
+    slave.command("input32 35 15000");          // outputpower 1500.0 W
+    slave.command("input 37 5001 2305");        // gridfrequency, gridvoltage
+    slave.command("input32 55 123456");         // energytotal 12345.6 kWh
+    slave.clearRequests();
+
+    uint8_t groups = PAYLOAD_GROUP(1) | PAYLOAD_GROUP(2);
+    CHECK_EQ(acquire(groups), growattIF::Success);
+    CHECK(modbusSnapshot.read(snap));
+    CHECK_EQ(snap.result, growattIF::Success);
+    CHECK_NEAR(snap.data.outputpower, 1500.0, 0.01);
+    CHECK_NEAR(snap.data.gridfrequency, 50.01, 0.001);
+    CHECK_NEAR(snap.data.gridvoltage, 230.5, 0.01);
+    CHECK_NEAR(snap.data.energytotal, 12345.6, 0.01);
+
+    LoraEncoder encoder(new uint8_t[64]);
+    encode_groups(groups, snap.result, snap.data, encoder);
+    CHECK(encoder.getLength() > 0);
+    CHECK(encoder.getLength() <= payload_size(groups));
+
+    uplinkScheduler.update(snap, 12);
+    CHECK_EQ(uplinkScheduler.state(), INV_PRODUCING);
+}
+
+static void testRetry(void)
+{
+    uint32_t crcErrors = rtStats.mbCrcErrors;
+    uint32_t retries   = rtStats.mbRetries;
+
+    // CRC error of the first request only
+    slave.command("at 1 crc 1000");
+    slave.command("at 2 crc 0");
+    CHECK_EQ(acquire(PAYLOAD_GROUP(1)), growattIF::Success);
+    CHECK_EQ(rtStats.mbCrcErrors, crcErrors + 1);
+    CHECK_EQ(rtStats.mbRetries, retries + 1);
+}
+
+#if defined(CAPTURE_EN)
+static void testCaptureMiss(void)
+{
+    Snapshot snap;
+
+    // failed capture poll (single attempt)
+    slave.command("at 1 crc 1000");
+    slave.command("at 2 crc 0");
+    slave.clearRequests();
+    CHECK_EQ(acquire(PAYLOAD_GROUP_CAPTURE), ModbusTransport::ku8MBInvalidCRC);
+    CHECK_EQ(slave.requests().size(), 1);
+
+    // next acquisition still reads the slave (no backoff)
+    slave.clearRequests();
+    CHECK_EQ(acquire(PAYLOAD_GROUPS_ALL), growattIF::Success);
+    CHECK(slave.requests().size() > 0);
+    CHECK(modbusSnapshot.read(snap));
+    CHECK_EQ(snap.result, growattIF::Success);
+}
+#endif
+
+static void testOffline(void)
+{
+    Snapshot snap;
+
+    slave.command("offline 1");
+    slave.clearRequests();
+    CHECK_EQ(acquire(PAYLOAD_GROUP(1)), ModbusTransport::ku8MBResponseTimedOut);
+    CHECK_EQ(slave.requests().size(), MODBUS_RETRIES);
+    CHECK(modbusSnapshot.read(snap));
+    CHECK_EQ(snap.result, ModbusTransport::ku8MBResponseTimedOut);
+
+    uplinkScheduler.update(snap, 12);
+    CHECK_EQ(uplinkScheduler.state(), INV_OFFLINE);
+
+    // skipped during backoff
+    slave.clearRequests();
+    CHECK_EQ(acquire(PAYLOAD_GROUP(1)), ModbusTransport::ku8MBResponseTimedOut);
+    CHECK_EQ(slave.requests().size(), 0);
+    slave.command("offline 0");
+}
+
+int main(void)
+{
+    if (!slave.start())
+        return 1;
+    Serial2.setDevice(slave.device());
+    ModbusLink::select();
+
+    testSettingsRetry();
+    testNormal();
+    testRetry();
+#if defined(CAPTURE_EN)
+    testCaptureMiss();
+#endif
+    testOffline();
+
+    slave.stop();
+    return check_result();
+}
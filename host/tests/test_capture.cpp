@@ -0,0 +1,120 @@
+///////////////////////////////////////////////////////////////////////////////
+// test_capture.cpp
+//
+// Host test: grid capture (CAPTURE_EN) - trigger, freeze, chunked sending
+// and re-arming with hysteresis and holdoff
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "check.h"
+#include "gridCapture.h"
+
+static uint32_t tSample = 0;
+
+static void addSample(GridCapture &cap, float voltage)
+{
+    modbus_input_registers data = {};
+
+    data.gridfrequency = 50.0f;
+    data.gridvoltage   = voltage;
+    data.outputpower   = 1000.0f;
+    tSample += CAPTURE_PERIOD;
+    cap.add(data, tSample);
+}
+
+// Add samples for the given time in seconds
+static void addSamples(GridCapture &cap, float voltage, uint32_t seconds)
+{
+    for (uint32_t i = 0; i < seconds * 1000 / CAPTURE_PERIOD; i++)
+        addSample(cap, voltage);
+}
+
+static void sendAll(GridCapture &cap)
+{
+    uint8_t buf[51];
+    uint16_t samples = 0;
+
+    while (cap.isReady()) {
+        LoraEncoder encoder(buf);
+        uint8_t n = cap.encode(encoder, sizeof(buf));
+        CHECK(n > 0);
+        if (n == 0)
+            return;
+        samples += n;
+        cap.sent();
+    }
+    CHECK_EQ(samples, CAPTURE_SIZE);
+}
+
+int main(void)
+{
+    GridCapture cap;
+
+    // normal values - no trigger
+    addSamples(cap, 230.0f, 20);
+    CHECK_EQ(cap.state(), GridCapture::CAP_ARMED);
+
+    // over-voltage - triggered, frozen after post-trigger window
+    addSample(cap, CAPTURE_VOLT_MAX + 5.0f);
+    CHECK_EQ(cap.state(), GridCapture::CAP_TRIGGERED);
+    for (uint16_t i = 0; i < CAPTURE_POST; i++)
+        addSample(cap, CAPTURE_VOLT_MAX + 5.0f);
+    CHECK_EQ(cap.state(), GridCapture::CAP_FROZEN);
+    CHECK(cap.isReady());
+    sendAll(cap);
+
+    // persistent over-voltage - no re-trigger
+    CHECK_EQ(cap.state(), GridCapture::CAP_HOLDOFF);
+    addSamples(cap, CAPTURE_VOLT_MAX + 5.0f, 2 * CAPTURE_REARM_HOLDOFF);
+    CHECK_EQ(cap.state(), GridCapture::CAP_HOLDOFF);
+
+    // inside the limits, but not inside the hysteresis band
+    addSamples(cap, CAPTURE_VOLT_MAX - CAPTURE_VOLT_HYST / 2, 2 * CAPTURE_REARM_HOLDOFF);
+    CHECK_EQ(cap.state(), GridCapture::CAP_HOLDOFF);
+
+    // normal values for less than the holdoff time
+    addSamples(cap, 230.0f, CAPTURE_REARM_HOLDOFF / 2);
+    addSample(cap, CAPTURE_VOLT_MAX + 5.0f);
+    CHECK_EQ(cap.state(), GridCapture::CAP_HOLDOFF);
+
+    // normal values for the holdoff time - re-armed, next deviation triggers
+    addSamples(cap, 230.0f, CAPTURE_REARM_HOLDOFF + 1);
+    CHECK_EQ(cap.state(), GridCapture::CAP_ARMED);
+    addSample(cap, CAPTURE_VOLT_MIN - 5.0f);
+    CHECK_EQ(cap.state(), GridCapture::CAP_TRIGGERED);
+
+    return check_result();
+}
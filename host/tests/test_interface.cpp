@@ -0,0 +1,164 @@
+///////////////////////////////////////////////////////////////////////////////
+// test_interface.cpp
+//
+// Host test: GrowattInterface (ModbusMaster transport) against the simulated
+// inverter on a pty - read plan, decoding, register write, injected
+// latency, CRC errors, timeouts and unknown slave IDs
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "check.h"
+#include "growattSlave.h"
+#include "growattInterface.h"
+
+static GrowattSlave slave;
+
+// Read all planned spans (returns final result)
+template <class F>
+static uint8_t readAll(F read)
+{
+    uint8_t result;
+    do {
+        result = read();
+    } while (result == growattIF::Continue);
+    return result;
+}
+
+static void testRead(growattIF &modbus)
+{
+    slave.command("input 0 1");                 // status
+    slave.command("input32 1 12345");           // solarpower 1234.5 W
+    slave.command("input 38 2301");             // gridvoltage 230.1 V
+    slave.command("input 37 4998");             // gridfrequency 49.98 Hz
+    slave.command("input 93 0xFFF6");           // tempinverter -1.0 degC
+    slave.command("input32 110 0x00010002");    // warningbitcode
+    slave.command("holding 3 100");             // maxoutputactivepp
+    slave.command("holding 9 0x4731 0x2E32 0x2E33");  // firmware "G1.2.3"
+    slave.clearRequests();
+
+    CHECK_EQ(readAll([&] { return modbus.ReadInputRegisters(); }), growattIF::Success);
+    CHECK_EQ(modbus.modbusdata.status, 1);
+    CHECK_NEAR(modbus.modbusdata.solarpower, 1234.5, 0.01);
+    CHECK_NEAR(modbus.modbusdata.gridvoltage, 230.1, 0.01);
+    CHECK_NEAR(modbus.modbusdata.gridfrequency, 49.98, 0.001);
+    CHECK_NEAR(modbus.modbusdata.tempinverter, -1.0, 0.01);
+    CHECK_EQ(modbus.modbusdata.warningbitcode, 0x00010002);
+
+    // one request per planned span, all answered
+    std::vector<SlaveRequest> req = slave.requests();
+    CHECK(!req.empty());
+    for (const SlaveRequest &r : req) {
+        CHECK_EQ(r.function, 0x04);
+        CHECK_EQ(r.result, 0);
+        CHECK(r.count <= MODBUS_MAX_BLOCK);
+    }
+
+    CHECK_EQ(readAll([&] { return modbus.ReadHoldingRegisters(); }), growattIF::Success);
+    CHECK_EQ(modbus.modbussettings.maxoutputactivepp, 100);
+    CHECK(memcmp(modbus.modbussettings.firmware, "G1.2.3", 6) == 0);
+}
+
+static void testWrite(growattIF &modbus)
+{
+    CHECK_EQ(modbus.writeRegister(growattIF::regMaxOutputActive, 42), ModbusMaster::ku8MBSuccess);
+    CHECK_EQ(slave.holding(growattIF::regMaxOutputActive), 42);
+
+    uint16_t value;
+    CHECK_EQ(modbus.readRegister(growattIF::regMaxOutputActive, value), ModbusMaster::ku8MBSuccess);
+    CHECK_EQ(value, 42);
+}
+
+static void testLatency(growattIF &modbus)
+{
+    uint16_t value;
+
+    slave.command("latency 100");
+    uint32_t t = millis();
+    CHECK_EQ(modbus.readRegister(0, value), ModbusMaster::ku8MBSuccess);
+    t = millis() - t;
+    CHECK(t >= 100);
+    CHECK(t < ModbusMaster::ku16MBResponseTimeout);
+    slave.command("latency 0");
+}
+
+static void testErrors(growattIF &modbus)
+{
+    uint16_t value;
+
+    // every response with CRC error
+    slave.command("crc 1000");
+    CHECK_EQ(modbus.readRegister(0, value), ModbusMaster::ku8MBInvalidCRC);
+    slave.command("crc 0");
+
+    // no response
+    slave.command("offline 1");
+    CHECK_EQ(modbus.readRegister(0, value), ModbusMaster::ku8MBResponseTimedOut);
+    slave.command("offline 0");
+
+    // exception: register address out of range
+    CHECK_EQ(modbus.readRegister(SLAVE_REGS_NUM, value), ModbusMaster::ku8MBIllegalDataAddress);
+
+    // unknown slave ID
+    modbus.setSlave(7);
+    CHECK_EQ(modbus.readRegister(0, value), ModbusMaster::ku8MBResponseTimedOut);
+    modbus.setSlave(1);
+
+    // scripted errors: CRC error of the next request only
+    slave.command("at 1 crc 1000");
+    slave.command("at 2 crc 0");
+    CHECK_EQ(modbus.readRegister(0, value), ModbusMaster::ku8MBInvalidCRC);
+    CHECK_EQ(modbus.readRegister(0, value), ModbusMaster::ku8MBSuccess);
+}
+
+int main(void)
+{
+    if (!slave.start())
+        return 1;
+    Serial2.setDevice(slave.device());
+
+    growattIF modbus;
+    ModbusLink::select();
+    modbus.begin();
+    modbus.setSlave(1);
+
+    testRead(modbus);
+    testWrite(modbus);
+    testLatency(modbus);
+    testErrors(modbus);
+
+    slave.stop();
+    return check_result();
+}
@@ -0,0 +1,239 @@
+///////////////////////////////////////////////////////////////////////////////
+// test_planner.cpp
+//
+// Host test: read planner (planReads()) - gap coalescing, max. request
+// length, span overflow, field selection and the resulting Modbus
+// transactions against the simulated inverter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "check.h"
+#include "growattSlave.h"
+#include "growattInterface.h"
+
+struct TestData {
+    int a, b, c, d, e;
+};
+
+// Registers 0, 2/3, 10, 30 and 7/8 (unsorted)
+static constexpr RegDesc testMap[] = {
+    REG_I(TestData, a,  0, 1, false),
+    REG_I(TestData, b,  2, 2, false),
+    REG_I(TestData, c, 10, 1, false),
+    REG_I(TestData, d, 30, 1, false),
+    REG_I(TestData, e,  7, 2, false)
+};
+#define NUM_TEST_DESC (sizeof(testMap) / sizeof(RegDesc))
+
+static bool spanIs(const RegSpan &s, uint16_t start, uint16_t count)
+{
+    return (s.start == start) && (s.count == count);
+}
+
+static void testGap(void)
+{
+    RegSpan spans[MAX_READ_SPANS];
+
+    // no gap allowed
+    CHECK_EQ(planReads(testMap, NUM_TEST_DESC, nullptr, 0, 0, 64, spans, MAX_READ_SPANS), 5);
+    CHECK(spanIs(spans[0], 0, 1));
+    CHECK(spanIs(spans[1], 2, 2));
+    CHECK(spanIs(spans[2], 7, 2));
+    CHECK(spanIs(spans[3], 10, 1));
+    CHECK(spanIs(spans[4], 30, 1));
+
+    // gaps of 1 (register 1, 9) and 3 (registers 4...6) coalesced
+    CHECK_EQ(planReads(testMap, NUM_TEST_DESC, nullptr, 0, 3, 64, spans, MAX_READ_SPANS), 2);
+    CHECK(spanIs(spans[0], 0, 11));
+    CHECK(spanIs(spans[1], 30, 1));
+
+    // gap of 2 is too large for registers 4...6
+    CHECK_EQ(planReads(testMap, NUM_TEST_DESC, nullptr, 0, 2, 64, spans, MAX_READ_SPANS), 3);
+    CHECK(spanIs(spans[0], 0, 4));
+    CHECK(spanIs(spans[1], 7, 4));
+    CHECK(spanIs(spans[2], 30, 1));
+
+    // everything in one request
+    CHECK_EQ(planReads(testMap, NUM_TEST_DESC, nullptr, 0, 19, 64, spans, MAX_READ_SPANS), 1);
+    CHECK(spanIs(spans[0], 0, 31));
+}
+
+static void testMaxLen(void)
+{
+    RegSpan spans[MAX_READ_SPANS];
+
+    // 32-bit value at 7/8 is not split
+    CHECK_EQ(planReads(testMap, NUM_TEST_DESC, nullptr, 0, 100, 8, spans, MAX_READ_SPANS), 3);
+    CHECK(spanIs(spans[0], 0, 4));
+    CHECK(spanIs(spans[1], 7, 4));
+    CHECK(spanIs(spans[2], 30, 1));
+
+    // register maps with MODBUS_MAX_BLOCK
+    uint8_t n = planReads(inputRegisterMap, NUM_INPUT_REGS_DESC, nullptr, 0,
+                          MODBUS_MAX_BLOCK, MODBUS_MAX_BLOCK, spans, MAX_READ_SPANS);
+    CHECK(n > 1);
+    for (uint8_t i = 0; i < n; i++) {
+        CHECK(spans[i].count <= MODBUS_MAX_BLOCK);
+        if (i > 0)
+            CHECK(spans[i].start >= spans[i - 1].start + spans[i - 1].count);
+    }
+}
+
+static void testOverflow(void)
+{
+    RegSpan spans[MAX_READ_SPANS];
+
+    CHECK_EQ(planReads(testMap, NUM_TEST_DESC, nullptr, 0, 0, 64, spans, 4), 0);
+    CHECK_EQ(planReads(testMap, NUM_TEST_DESC, nullptr, 0, 0, 64, spans, 5), 5);
+    CHECK_EQ(planReads(testMap, NUM_TEST_DESC, nullptr, 0, 3, 64, spans, 1), 0);
+}
+
+static void testFields(void)
+{
+    RegSpan spans[MAX_READ_SPANS];
+    RegSpan all[MAX_READ_SPANS];
+
+    // unsorted selection
+    const size_t fields[] = { offsetof(TestData, d), offsetof(TestData, a) };
+    CHECK_EQ(planReads(testMap, NUM_TEST_DESC, fields, 2, 0, 64, spans, MAX_READ_SPANS), 2);
+    CHECK(spanIs(spans[0], 0, 1));
+    CHECK(spanIs(spans[1], 30, 1));
+
+    // no fields
+    CHECK_EQ(planReads(testMap, NUM_TEST_DESC, fields, 0, 0, 64, spans, MAX_READ_SPANS), 0);
+
+    // nullptr selects all fields - same as listing all fields
+    const size_t allFields[] = {
+        offsetof(TestData, a), offsetof(TestData, b), offsetof(TestData, c),
+        offsetof(TestData, d), offsetof(TestData, e)
+    };
+    uint8_t n = planReads(testMap, NUM_TEST_DESC, nullptr, 0, 2, 64, all, MAX_READ_SPANS);
+    CHECK_EQ(planReads(testMap, NUM_TEST_DESC, allFields, 5, 2, 64, spans, MAX_READ_SPANS), n);
+    for (uint8_t i = 0; i < n; i++)
+        CHECK(spanIs(spans[i], all[i].start, all[i].count));
+
+    // every descriptor of the input register map is covered
+    n = planReads(inputRegisterMap, NUM_INPUT_REGS_DESC, nullptr, 0,
+                  MODBUS_MAX_BLOCK, MODBUS_MAX_BLOCK, all, MAX_READ_SPANS);
+    for (size_t i = 0; i < NUM_INPUT_REGS_DESC; i++) {
+        const RegDesc &d = inputRegisterMap[i];
+        bool covered = false;
+        for (uint8_t j = 0; j < n; j++)
+            covered |= (d.addr >= all[j].start) && (d.addr + d.width <= all[j].start + all[j].count);
+        CHECK(covered);
+    }
+}
+
+// Planned spans are read with one transaction each
+static void testTransactions(void)
+{
+    GrowattSlave slave;
+    growattIF modbus;
+    RegSpan spans[MAX_READ_SPANS];
+    uint8_t result;
+
+    if (!slave.start()) {
+        CHECK(false);
+        return;
+    }
+    CHECK(slave.load(HOST_DATA_DIR "/input_registers.txt"));
+    Serial2.setDevice(slave.device());
+    ModbusLink::select();
+    modbus.begin();
+    modbus.setSlave(1);
+
+    const size_t fields[] = {
+        INPUT_FIELD(gridvoltage), INPUT_FIELD(status), INPUT_FIELD(faultbitcode), INPUT_FIELD(energytotal)
+    };
+    const uint16_t maxGap = 4;
+    uint8_t n = planReads(inputRegisterMap, NUM_INPUT_REGS_DESC, fields, 4,
+                          maxGap, MODBUS_MAX_BLOCK, spans, MAX_READ_SPANS);
+    CHECK_EQ(n, 4);
+
+    slave.clearRequests();
+    modbus.planInputRegisters(fields, 4, maxGap);
+    do {
+        result = modbus.ReadInputRegisters();
+    } while (result == growattIF::Continue);
+    CHECK_EQ(result, growattIF::Success);
+
+    std::vector<SlaveRequest> req = slave.requests();
+    CHECK_EQ(req.size(), n);
+    for (uint8_t i = 0; (i < n) && (i < req.size()); i++) {
+        CHECK_EQ(req[i].function, 0x04);
+        CHECK_EQ(req[i].addr, spans[i].start);
+        CHECK_EQ(req[i].count, spans[i].count);
+    }
+
+    // selected fields decoded, registers not read are 0
+    CHECK_EQ(modbus.modbusdata.status, 1);
+    CHECK_NEAR(modbus.modbusdata.gridvoltage, 231.6, 0.01);
+    CHECK_NEAR(modbus.modbusdata.energytotal, 7713.1, 0.01);
+    CHECK_EQ(modbus.modbusdata.faultbitcode, 0x20000000);
+    CHECK_NEAR(modbus.modbusdata.tempinverter, 0.0, 0.01);
+    CHECK_EQ(modbus.modbusdata.warningbitcode, 0);
+
+    // too many spans - all registers are read
+    const size_t scattered[] = {
+        INPUT_FIELD(status), INPUT_FIELD(pv1voltage), INPUT_FIELD(pv2voltage), INPUT_FIELD(outputpower),
+        INPUT_FIELD(energytoday), INPUT_FIELD(totalworktime), INPUT_FIELD(pv1energytotal),
+        INPUT_FIELD(tempinverter), INPUT_FIELD(ipf), INPUT_FIELD(faultcode)
+    };
+    CHECK_EQ(planReads(inputRegisterMap, NUM_INPUT_REGS_DESC, scattered, 10,
+                       0, MODBUS_MAX_BLOCK, spans, MAX_READ_SPANS), 0);
+    n = planReads(inputRegisterMap, NUM_INPUT_REGS_DESC, nullptr, 0,
+                  MODBUS_MAX_BLOCK, MODBUS_MAX_BLOCK, spans, MAX_READ_SPANS);
+    slave.clearRequests();
+    modbus.planInputRegisters(scattered, 10, 0);
+    do {
+        result = modbus.ReadInputRegisters();
+    } while (result == growattIF::Continue);
+    CHECK_EQ(result, growattIF::Success);
+    CHECK_EQ(slave.requests().size(), n);
+    CHECK_NEAR(modbus.modbusdata.tempinverter, 41.2, 0.01);
+
+    slave.stop();
+}
+
+int main(void)
+{
+    testGap();
+    testMaxLen();
+    testOverflow();
+    testFields();
+    testTransactions();
+    return check_result();
+}
@@ -0,0 +1,222 @@
+///////////////////////////////////////////////////////////////////////////////
+// test_registers.cpp
+//
+// Host test: register map (growattRegisters.h) - decoding of the recorded
+// input and holding register dumps (host/data/) and consistency of the
+// register descriptor tables, exact encoding of totals above 2^24 counts
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "check.h"
+#include "growattSlave.h"
+#include "growattInterface.h"
+#include "payload.h"
+
+static GrowattSlave slave;
+
+// Descriptors must be within the register image and must not overlap
+static void testTable(const RegDesc *table, size_t n, size_t nregs)
+{
+    CHECK(n <= MAX_REGS_DESC);
+    for (size_t i = 0; i < n; i++) {
+        CHECK(table[i].addr + table[i].width <= nregs);
+        for (size_t j = i + 1; j < n; j++) {
+            bool overlap = (table[i].addr < table[j].addr + table[j].width) &&
+                           (table[j].addr < table[i].addr + table[i].width);
+            if (overlap)
+                fprintf(stderr, "%s/%s overlap\n", table[i].name, table[j].name);
+            CHECK(!overlap);
+        }
+    }
+}
+
+static void testInput(modbus_input_registers &data)
+{
+    uint16_t regs[INPUT_REGS_NUM];
+
+    for (uint16_t i = 0; i < INPUT_REGS_NUM; i++)
+        regs[i] = slave.input(i);
+    memset(&data, 0, sizeof(data));
+    decodeRegisters(inputRegisterMap, NUM_INPUT_REGS_DESC, regs, INPUT_REGS_NUM, &data);
+
+    CHECK_EQ(data.status, 1);
+    CHECK_NEAR(data.solarpower, 1234.5, 0.01);
+    CHECK_NEAR(data.pv1voltage, 345.2, 0.01);
+    CHECK_NEAR(data.pv1current, 3.6, 0.01);
+    CHECK_NEAR(data.pv1power, 1234.5, 0.01);
+    CHECK_NEAR(data.pv2voltage, 0.0, 0.01);
+    CHECK_NEAR(data.pv2current, 0.0, 0.01);
+    CHECK_NEAR(data.pv2power, 0.0, 0.01);
+    CHECK_NEAR(data.outputpower, 1198.3, 0.01);
+    CHECK_NEAR(data.gridfrequency, 49.98, 0.001);
+    CHECK_NEAR(data.gridvoltage, 231.6, 0.01);
+    CHECK_NEAR(data.energytoday, 5.2, 0.01);
+    CHECK_NEAR(data.energytotal, 7713.1, 0.01);
+    CHECK_NEAR(data.totalworktime, 8559888.0, 1.0);
+    CHECK_NEAR(data.pv1energytoday, 5.4, 0.01);
+    CHECK_NEAR(data.pv1energytotal, 7759.4, 0.01);
+    CHECK_NEAR(data.pv2energytoday, 0.0, 0.01);
+    CHECK_NEAR(data.pv2energytotal, 0.0, 0.01);
+    CHECK_NEAR(data.tempinverter, 41.2, 0.01);
+    CHECK_NEAR(data.tempipm, 45.5, 0.01);
+    CHECK_NEAR(data.tempboost, -2.0, 0.01);     // signed
+    CHECK_EQ(data.ipf, 20000);
+    CHECK_EQ(data.realoppercent, 80);
+    CHECK_NEAR(data.opfullpower, 1500.0, 0.01);
+
+    // raw values of totals
+    CHECK_EQ(data.energytotal_raw, 77131);
+    CHECK_EQ(data.totalworktime_raw, 17119776);
+    CHECK_EQ(data.pv1energytotal_raw, 77594);
+
+    // diagnostic registers - formerly mapped to 103 (deratingmode)
+    // and 105 (faultbitcode)
+    CHECK_EQ(data.deratingmode, 3);
+    CHECK_EQ(data.faultcode, 30);
+    CHECK_EQ(data.faultbitcode, 0x20000000);
+    CHECK_EQ(data.warningbitcode, 0x00000001);
+}
+
+// Totals above 2^24 counts are not exact as float - payload uses raw values
+static void testTotals(void)
+{
+    uint16_t regs[INPUT_REGS_NUM] = {};
+    modbus_input_registers data = {};
+    uint8_t buf[64];
+
+    regs[55] = 0x0100;                          // energytotal    0x01000001
+    regs[56] = 0x0001;
+    regs[57] = 0x0123;                          // totalworktime  0x01234567
+    regs[58] = 0x4567;
+    regs[61] = 0x0765;                          // pv1energytotal 0x07654321
+    regs[62] = 0x4321;
+    decodeRegisters(inputRegisterMap, NUM_INPUT_REGS_DESC, regs, INPUT_REGS_NUM, &data);
+    CHECK_EQ(data.energytotal_raw, 0x01000001);
+    CHECK_EQ(data.totalworktime_raw, 0x01234567);
+    CHECK_EQ(data.pv1energytotal_raw, 0x07654321);
+    CHECK(lroundf(data.totalworktime * 2) != 0x01234567);
+
+    // port 1: energytotal at byte 6, totalworktime at byte 10 (little endian)
+    LoraEncoder encoder(buf);
+    encode_payload(1, growattIF::Success, data, encoder);
+    uint32_t energy = buf[6] | (buf[7] << 8) | (buf[8] << 16) | ((uint32_t)buf[9] << 24);
+    uint32_t work   = buf[10] | (buf[11] << 8) | (buf[12] << 16) | ((uint32_t)buf[13] << 24);
+    CHECK_EQ(energy, 0x01000001);
+    CHECK_EQ(work, 0x01234567);
+
+    // port 2: pv1energytotal at byte 14
+    LoraEncoder encoder2(buf);
+    encode_payload(2, growattIF::Success, data, encoder2);
+    uint32_t pv1 = buf[14] | (buf[15] << 8) | (buf[16] << 16) | ((uint32_t)buf[17] << 24);
+    CHECK_EQ(pv1, 0x07654321);
+}
+
+static void testHolding(modbus_holding_registers &data)
+{
+    uint16_t regs[HOLDING_REGS_NUM];
+
+    for (uint16_t i = 0; i < HOLDING_REGS_NUM; i++)
+        regs[i] = slave.holding(i);
+    memset(&data, 0, sizeof(data));
+    decodeRegisters(holdingRegisterMap, NUM_HOLDING_REGS_DESC, regs, HOLDING_REGS_NUM, &data);
+
+    CHECK_EQ(data.enable, 1);
+    CHECK_EQ(data.safetyfuncen, 0x0018);
+    CHECK_EQ(data.maxoutputactivepp, 100);
+    CHECK_EQ(data.maxoutputreactivepp, 255);
+    CHECK_NEAR(data.maxpower, 1500.0, 0.01);
+    CHECK_NEAR(data.voltnormal, 230.0, 0.01);
+    CHECK(memcmp(data.firmware, "GH1.0 ", 6) == 0);
+    CHECK(memcmp(data.controlfirmware, "ZB1.1 ", 6) == 0);
+    CHECK_NEAR(data.startvoltage, 100.0, 0.01);
+    CHECK(memcmp(data.serial, "AB12345678", 10) == 0);
+    CHECK_NEAR(data.gridvoltlowlimit, 184.0, 0.01);
+    CHECK_NEAR(data.gridvolthighlimit, 253.0, 0.01);
+    CHECK_NEAR(data.gridfreqlowlimit, 47.5, 0.001);
+    CHECK_NEAR(data.gridfreqhighlimit, 51.5, 0.001);
+    CHECK_NEAR(data.gridvoltlowconnlimit, 195.0, 0.01);
+    CHECK_NEAR(data.gridvolthighconnlimit, 253.0, 0.01);
+    CHECK_NEAR(data.gridfreqlowconnlimit, 47.5, 0.001);
+    CHECK_NEAR(data.gridfreqhighconnlimit, 50.05, 0.001);
+    CHECK_EQ(data.modul, 4);
+}
+
+// Same result via Modbus (read plan, transport, decoding)
+static void testModbus(const modbus_input_registers &input, const modbus_holding_registers &holding)
+{
+    uint8_t result;
+    growattIF modbus;
+
+    Serial2.setDevice(slave.device());
+    ModbusLink::select();
+    modbus.begin();
+    modbus.setSlave(1);
+    memset(&modbus.modbusdata, 0, sizeof(modbus.modbusdata));
+    memset(&modbus.modbussettings, 0, sizeof(modbus.modbussettings));
+
+    do {
+        result = modbus.ReadInputRegisters();
+    } while (result == growattIF::Continue);
+    CHECK_EQ(result, growattIF::Success);
+    CHECK(memcmp(&modbus.modbusdata, &input, sizeof(input)) == 0);
+
+    do {
+        result = modbus.ReadHoldingRegisters();
+    } while (result == growattIF::Continue);
+    CHECK_EQ(result, growattIF::Success);
+    CHECK(memcmp(&modbus.modbussettings, &holding, sizeof(holding)) == 0);
+}
+
+int main(void)
+{
+    modbus_input_registers   input;
+    modbus_holding_registers holding;
+
+    testTable(inputRegisterMap, NUM_INPUT_REGS_DESC, INPUT_REGS_NUM);
+    testTable(holdingRegisterMap, NUM_HOLDING_REGS_DESC, HOLDING_REGS_NUM);
+
+    CHECK(slave.load(HOST_DATA_DIR "/input_registers.txt"));
+    CHECK(slave.load(HOST_DATA_DIR "/holding_registers.txt"));
+    testInput(input);
+    testTotals();
+    testHolding(holding);
+
+    if (!slave.start())
+        return 1;
+    testModbus(input, holding);
+    slave.stop();
+    return check_result();
+}
@@ -0,0 +1,157 @@
+///////////////////////////////////////////////////////////////////////////////
+// test_ringlog.cpp
+//
+// Host test: ring log (RINGLOG_EN) - dedicated partition, no fallback to
+// other partitions, write/read/markSent and wrap around
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "check.h"
+#include "ringlog.h"
+
+static bool isErased(const esp_partition_t *part)
+{
+    uint8_t buf[4096];
+
+    for (uint32_t offset = 0; offset < part->size; offset += sizeof(buf)) {
+        esp_partition_read(part, offset, buf, sizeof(buf));
+        for (size_t i = 0; i < sizeof(buf); i++) {
+            if (buf[i] != 0xFF)
+                return false;
+        }
+    }
+    return true;
+}
+
+static void testLog(void)
+{
+    RingLog log;
+    RingRecord recs[4];
+    uint8_t data[RINGLOG_DATA_SIZE];
+
+    CHECK(log.begin());
+    CHECK_EQ(log.pending(), 0);
+
+    for (uint8_t i = 0; i < 3; i++) {
+        memset(data, i, sizeof(data));
+        CHECK(log.write(1000 + i, data, sizeof(data)));
+    }
+    CHECK_EQ(log.pending(), 3);
+
+    CHECK_EQ(log.read(recs, 2), 2);
+    CHECK_EQ(recs[0].time, 1000);
+    CHECK_EQ(recs[1].time, 1001);
+    CHECK_EQ(recs[1].data[0], 1);
+    log.markSent();
+    CHECK_EQ(log.pending(), 1);
+
+    CHECK_EQ(log.read(recs, 4), 1);
+    CHECK_EQ(recs[0].time, 1002);
+    log.markSent();
+    CHECK_EQ(log.pending(), 0);
+
+    // wrap around - oldest records are overwritten
+    uint32_t size = min((uint32_t)RINGLOG_SIZE, (uint32_t)0x10000);
+    uint32_t num  = size / sizeof(RingRecord);
+    for (uint32_t i = 0; i < num + 10; i++)
+        CHECK(log.write(2000 + i, data, 4));
+    CHECK(log.pending() < num);
+    CHECK(log.pending() >= num - RINGLOG_SECTOR / sizeof(RingRecord));
+    CHECK_EQ(log.read(recs, 1), 1);
+    CHECK(recs[0].time > 2000);
+}
+
+static void testHold(void)
+{
+    RingLog log;
+    RingRecord recs[RINGLOG_HOLD];
+    uint8_t data[RINGLOG_DATA_SIZE];
+
+    CHECK(log.begin());
+    while (log.read(recs, RINGLOG_HOLD))
+        log.markSent();
+    CHECK_EQ(log.pending(), 0);
+
+    // acknowledged confirmed uplink - held readings are dropped
+    memset(data, 1, sizeof(data));
+    log.hold(3000, data, sizeof(data));
+    log.hold(3001, data, 0);
+    log.hold(3002, data, sizeof(data));
+    CHECK_EQ(log.held(), 2);
+    log.release(true);
+    CHECK_EQ(log.held(), 0);
+    CHECK_EQ(log.pending(), 0);
+
+    // failed confirmed uplink - held readings are logged in order
+    log.hold(4000, data, sizeof(data));
+    log.hold(4001, data, sizeof(data));
+    log.release(false);
+    CHECK_EQ(log.held(), 0);
+    CHECK_EQ(log.pending(), 2);
+    CHECK_EQ(log.read(recs, RINGLOG_HOLD), 2);
+    CHECK_EQ(recs[0].time, 4000);
+    CHECK_EQ(recs[1].time, 4001);
+    log.markSent();
+
+    // more than RINGLOG_HOLD readings - oldest one is logged
+    for (uint32_t i = 0; i <= RINGLOG_HOLD; i++)
+        log.hold(5000 + i, data, sizeof(data));
+    CHECK_EQ(log.held(), RINGLOG_HOLD);
+    CHECK_EQ(log.pending(), 1);
+    CHECK_EQ(log.read(recs, 1), 1);
+    CHECK_EQ(recs[0].time, 5000);
+    log.markSent();
+    log.release(true);
+}
+
+int main(void)
+{
+    const esp_partition_t *spiffs = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                             ESP_PARTITION_SUBTYPE_DATA_SPIFFS, nullptr);
+    CHECK(spiffs != nullptr);
+
+    testLog();
+    testHold();
+    CHECK(isErased(spiffs));
+
+    // default partition table without "ringlog" - SPIFFS is not touched
+    host_partition_remove(RINGLOG_LABEL);
+    RingLog log;
+    CHECK(!log.begin());
+    CHECK(isErased(spiffs));
+
+    return check_result();
+}
@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+// test_stats.cpp
+//
+// Host test: runtime statistics - no saturation at 0xFFFF, no lost
+// increments from concurrent tasks, encoding of CMD_GET_STATS response
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "check.h"
+#include "stats.h"
+#include <thread>
+
+#define INCREMENTS  100000
+
+int main(void)
+{
+    // acquisition task and loop() increment concurrently
+    rtStats = RuntimeStats();
+    auto task = [] {
+        for (int i = 0; i < INCREMENTS; i++)
+            stats_inc(rtStats.mbRequests);
+    };
+    std::thread t1(task);
+    std::thread t2(task);
+    t1.join();
+    t2.join();
+    CHECK_EQ(rtStats.mbRequests, 2 * INCREMENTS);
+
+    // encoded: low 24 bits, little endian
+    rtStats.wakeups    = 0x01234567;
+    rtStats.mbRequests = 0x00FFFFFF;
+    stats_inc(rtStats.mbRequests);
+    CHECK_EQ(rtStats.mbRequests, 0x01000000);
+    stats_add(rtStats.acqTime, 100);
+    stats_add(rtStats.acqTime, 300);
+
+    uint8_t buf[STATS_SIZE + 8];
+    LoraEncoder encoder(buf);
+    encode_stats(encoder);
+    CHECK_EQ(encoder.getLength(), STATS_SIZE);
+    CHECK(STATS_SIZE <= 51);
+    CHECK_EQ(buf[0], 0x67);
+    CHECK_EQ(buf[1], 0x45);
+    CHECK_EQ(buf[2], 0x23);
+    CHECK_EQ(buf[3] | buf[4] | buf[5], 0);
+    CHECK_EQ(buf[33] | (buf[34] << 8), 100);    // acquisition time min
+    CHECK_EQ(buf[35] | (buf[36] << 8), 300);    // max
+    CHECK_EQ(buf[37] | (buf[38] << 8), 200);    // mean
+
+    return check_result();
+}
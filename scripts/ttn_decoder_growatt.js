@@ -66,6 +66,63 @@ function ttn_decoder(bytes, port) {
     };
     uint16fp1.BYTES = 2;
 
+    var uint16fp2 = function (bytes) {
+        if (bytes.length !== uint16.BYTES) {
+            throw new Error('int must have exactly 2 bytes');
+        }
+        var res = bytesToInt(bytes) * 0.01;
+        return res.toFixed(2);
+    };
+    uint16fp2.BYTES = 2;
+
+    var int16fp1 = function (bytes) {
+        if (bytes.length !== int16fp1.BYTES) {
+            throw new Error('int must have exactly 2 bytes');
+        }
+        var i = bytesToInt(bytes);
+        if (i & 0x8000) {
+            i -= 0x10000;
+        }
+        var res = i * 0.1;
+        return res.toFixed(1);
+    };
+    int16fp1.BYTES = 2;
+
+    var uint32fp1 = function (bytes) {
+        if (bytes.length !== uint32fp1.BYTES) {
+            throw new Error('int must have exactly 4 bytes');
+        }
+        var res = (bytesToInt(bytes) >>> 0) * 0.1;
+        return res.toFixed(1);
+    };
+    uint32fp1.BYTES = 4;
+
+    var uint32fp05 = function (bytes) {
+        if (bytes.length !== uint32fp05.BYTES) {
+            throw new Error('int must have exactly 4 bytes');
+        }
+        var res = (bytesToInt(bytes) >>> 0) * 0.5;
+        return res.toFixed(1);
+    };
+    uint32fp05.BYTES = 4;
+
+    var uint16fp05 = function (bytes) {
+        if (bytes.length !== uint16fp05.BYTES) {
+            throw new Error('int must have exactly 2 bytes');
+        }
+        var res = bytesToInt(bytes) * 0.5;
+        return res.toFixed(1);
+    };
+    uint16fp05.BYTES = 2;
+
+    var uint24 = function (bytes) {
+        if (bytes.length !== uint24.BYTES) {
+            throw new Error('int must have exactly 3 bytes');
+        }
+        return bytesToInt(bytes);
+    };
+    uint24.BYTES = 3;
+
     var uint32 = function (bytes) {
         if (bytes.length !== uint32.BYTES) {
             throw new Error('int must have exactly 4 bytes');
@@ -74,6 +131,18 @@ function ttn_decoder(bytes, port) {
     };
     uint32.BYTES = 4;
 
+    // ASCII string with fixed length (trailing NUL/blanks removed)
+    var ascii = function (len) {
+        var fn = function (bytes) {
+            if (bytes.length !== len) {
+                throw new Error('String must have exactly ' + len + ' bytes');
+            }
+            return String.fromCharCode.apply(null, bytes).replace(/[\0 ]+$/, '');
+        };
+        fn.BYTES = len;
+        return fn;
+    };
+
     var latLng = function (bytes) {
         if (bytes.length !== latLng.BYTES) {
             throw new Error('Lat/Long must have exactly 8 bytes');
@@ -181,6 +250,7 @@ function ttn_decoder(bytes, port) {
             unixtime: unixtime,
             uint8: uint8,
             uint16: uint16,
+            uint24: uint24,
             uint32: uint32,
             temperature: temperature,
             humidity: humidity,
@@ -188,11 +258,290 @@ function ttn_decoder(bytes, port) {
             bitmap: bitmap,
             rawfloat: rawfloat,
             uint16fp1: uint16fp1,
+            uint16fp2: uint16fp2,
+            int16fp1: int16fp1,
+            uint32fp1: uint32fp1,
+            uint32fp05: uint32fp05,
+            uint16fp05: uint16fp05,
             modbus: modbus,
             decode: decode
         };
     }
 
+    // Decode data group of compact/grouped payload format
+    // (group 1: port 1 data, group 2: port 2 data, group 3: aggregated data)
+    var groupDecode = function (bytes, group, delta) {
+        var mask, names;
+        if (group === 3) {
+            mask = [uint16, uint16,
+                uint16, uint16, uint16, uint16,
+                uint16, uint16, uint16, uint16,
+                uint16fp1, uint16fp1, uint16fp1
+            ];
+            names = ['agg_samples', 'agg_duration',
+                'outputpower_min', 'outputpower_max', 'outputpower_avg', 'outputenergy_wh',
+                'pv1power_min', 'pv1power_max', 'pv1power_avg', 'pv1energy_wh',
+                'gridvoltage_min', 'gridvoltage_max', 'gridvoltage_avg'
+            ];
+        } else if (group === 1) {
+            mask = [uint8, uint8, uint16fp1,
+                delta ? uint16fp1 : uint32fp1,
+                delta ? uint16fp05 : uint32fp05,
+                uint16, uint16fp1, uint16fp2
+            ];
+            names = ['status', 'faultcode', 'energytoday',
+                delta ? 'energytotal_delta' : 'energytotal',
+                delta ? 'totalworktime_delta' : 'totalworktime',
+                'outputpower', 'gridvoltage', 'gridfrequency'
+            ];
+        } else {
+            mask = [uint16fp1, uint16fp1, uint16, int16fp1, int16fp1, uint16fp1,
+                delta ? uint16fp1 : uint32fp1
+            ];
+            names = ['pv1voltage', 'pv1current', 'pv1power', 'tempinverter', 'tempipm', 'pv1energytoday',
+                delta ? 'pv1energytotal_delta' : 'pv1energytotal'
+            ];
+        }
+        var size = mask.reduce(function (prev, cur) {
+            return prev + cur.BYTES;
+        }, 0);
+        return { size: size, data: decode(bytes.slice(0, size), mask, names) };
+    };
+
+    // Runtime statistics (response to CMD_GET_STATS)
+    if (port === 7) {
+        return decode(
+            bytes,
+            [uint24, uint24, uint24, uint24, uint24, uint24, uint24, uint24,
+                uint24, uint24, uint24,
+                uint16, uint16, uint16, uint16, uint16, uint16
+            ],
+            ['wakeups', 'mb_requests', 'mb_continue', 'mb_errors', 'mb_timeouts', 'mb_crc_errors', 'mb_retries', 'acq_failed',
+                'uplinks', 'uplinks_busy', 'uplinks_failed',
+                'acq_time_min', 'acq_time_max', 'acq_time_avg', 'wake_time_min', 'wake_time_max', 'wake_time_avg'
+            ]
+        );
+    }
+
+    // Multi-inverter payload - summary of each inverter
+    if (port === 8) {
+        var inverters = [];
+        var pos = 1;
+        for (var n = 0; n < bytes[0]; n++) {
+            var inv = { "slave": bytes[pos], "modbus": modbus(bytes.slice(pos + 1, pos + 2)) };
+            pos += 2;
+            if (bytes[pos - 1] === 0) {
+                var summary = decode(
+                    bytes.slice(pos, pos + 10),
+                    [uint8, uint8, uint16, uint16fp1, uint32fp1],
+                    ['status', 'faultcode', 'outputpower', 'energytoday', 'energytotal']
+                );
+                for (var k in summary) {
+                    inv[k] = summary[k];
+                }
+                pos += 10;
+            }
+            inverters.push(inv);
+        }
+        return { "inverters": inverters };
+    }
+
+    // Backfill payload - readings stored while the link was down
+    if (port === 9) {
+        var records = [];
+        for (var r = 0; r < bytes[0]; r++) {
+            var p = 1 + r * 18;
+            records.push(decode(
+                bytes.slice(p, p + 18),
+                [unixtime, uint32fp1, uint16fp1, uint16, uint32fp1, uint8, uint8],
+                ['time', 'energytotal', 'energytoday', 'outputpower', 'pv1energytotal', 'status', 'faultcode']
+            ));
+        }
+        return { "records": records };
+    }
+
+    // Fault/warning events - bits raised/cleared since the previous poll
+    // (bit meanings see growattRegisters.h)
+    if (port === 10) {
+        var fault_bits = [
+            "Bit0", "Communication error", "Bit2", "StrReverse or StrShort fault",
+            "Model Init fault", "Grid Volt Sample different", "ISO Sample different", "GFCI Sample different",
+            "Bit8", "Bit9", "Bit10", "Bit11",
+            "AFCI Fault", "Bit13", "AFCI Module fault", "Bit15",
+            "Bit16", "Relay check fault", "Bit18", "Bit19",
+            "Bit20", "Communication error", "Bus Voltage error", "AutoTest fail",
+            "No Utility", "PV Isolation Low", "Residual I High", "Output High DCI",
+            "PV Voltage high", "AC V Outrange", "AC F Outrange", "Temperature High"
+        ];
+        var warning_bits = [
+            "Fan warning", "String communication abnormal", "StrPIDconfig Warning", "Bit3",
+            "DSP and COM firmware unmatch", "Bit5", "SPD abnormal", "GND and N connect abnormal",
+            "PV1 or PV2 circuit short", "PV1 or PV2 boost driver broken", "Bit10", "Bit11",
+            "Bit12", "Bit13", "Bit14", "Bit15"
+        ];
+        var fault_code = {
+            24: "Auto Test", 25: "No AC", 26: "PV Isolation Low", 27: "Residual I",
+            28: "Output High", 29: "PV Voltage", 30: "AC V Outrange", 31: "AC F Outrange",
+            32: "Module Hot"
+        };
+        var bitNames = function (mask, names) {
+            var res = [];
+            for (var b = 0; b < names.length; b++) {
+                if ((mask >>> b) & 1) {
+                    res.push(names[b]);
+                }
+            }
+            return res;
+        };
+        var events = [];
+        for (var e = 0; e < bytes[0]; e++) {
+            var q = 2 + e * 14;
+            var ev = decode(
+                bytes.slice(q, q + 14),
+                [unixtime, uint8, uint8, uint32, uint32],
+                ['time', 'type', 'faultcode', 'raised', 'cleared']
+            );
+            var names = (ev.type === 0) ? fault_bits : warning_bits;
+            ev.type = (ev.type === 0) ? "fault" : "warning";
+            ev.faultcode_text = ((ev.faultcode >= 1) && (ev.faultcode <= 23)) ?
+                "Error: " + (99 + ev.faultcode) : fault_code[ev.faultcode];
+            ev.raised = bitNames(ev.raised, names);
+            ev.cleared = bitNames(ev.cleared, names);
+            events.push(ev);
+        }
+        return { "dropped": bytes[1], "events": events };
+    }
+
+    // Grid capture - chunk of frequency/voltage/power window around a disturbance
+    // (header see gridCapture.h; following samples as zigzag varint differences)
+    if (port === 11) {
+        var cap = decode(
+            bytes.slice(0, 15),
+            [uint8, uint8, uint16, uint16, uint16, uint16, unixtime, uint8],
+            ['seq', 'cause', 'first', 'total', 'trigger', 'period', 'time', 'n']
+        );
+        var cur = [
+            bytes[15] | (bytes[16] << 8),
+            bytes[17] | (bytes[18] << 8),
+            bytes[19] | (bytes[20] << 8)
+        ];
+        var pos = 21;
+        var readVarint = function () {
+            var v = 0;
+            var shift = 0;
+            var b;
+            do {
+                b = bytes[pos++];
+                v |= (b & 0x7F) << shift;
+                shift += 7;
+            } while (b & 0x80);
+            return v;
+        };
+        var samples = [];
+        for (var s = 0; s < cap.n; s++) {
+            if (s > 0) {
+                for (var f = 0; f < 3; f++) {
+                    var z = readVarint();
+                    var d = (z >>> 1) ^ -(z & 1);
+                    cur[f] = (cur[f] + d) & 0xFFFF;
+                }
+            }
+            var valid = cur[0] !== 0xFFFF;
+            samples.push({
+                "t": (cap.first + s - cap.trigger) * cap.period / 1000,
+                "gridfrequency": valid ? cur[0] / 100 : null,
+                "gridvoltage": valid ? cur[1] / 10 : null,
+                "outputpower": valid ? cur[2] : null
+            });
+        }
+        cap.cause = [];
+        if (bytes[1] & 1) {
+            cap.cause.push("frequency");
+        }
+        if (bytes[1] & 2) {
+            cap.cause.push("voltage");
+        }
+        delete cap.n;
+        cap.samples = samples;
+        return cap;
+    }
+
+    // Configuration (response to CMD_GET_CONFIG) - 16 bit values are big endian
+    if (port === 4) {
+        var uint16be = function (i) {
+            return (bytes[i] << 8) | bytes[i + 1];
+        };
+        return {
+            "sleep_interval": uint16be(0),
+            "sleep_interval_long": uint16be(2),
+            "idle_interval": uint16be(4),
+            "min_power": uint16be(6),
+            "night_start": bytes[8],
+            "night_end": bytes[9]
+        };
+    }
+
+    // Inverter settings (response to CMD_GET_INVERTER_SETTINGS)
+    // byte 0: age of cached data in hours (0xFE: unknown, 0xFF: no data)
+    if (port === 5) {
+        var settings = { "age": (bytes[0] < 0xFE) ? bytes[0] : null, "available": bytes[0] !== 0xFF };
+        if (settings.available) {
+            var s = decode(
+                bytes.slice(1),
+                [uint8, uint8, uint8, uint8, uint16, uint16fp1, uint16fp1,
+                    uint16fp1, uint16fp1, uint16fp2, uint16fp2,
+                    uint16fp1, uint16fp1, uint16fp2, uint16fp2,
+                    uint16, ascii(6), ascii(6), ascii(10)
+                ],
+                ['enable', 'safetyfuncen', 'maxoutputactivepp', 'maxoutputreactivepp', 'maxpower', 'voltnormal', 'startvoltage',
+                    'gridvoltlowlimit', 'gridvolthighlimit', 'gridfreqlowlimit', 'gridfreqhighlimit',
+                    'gridvoltlowconnlimit', 'gridvolthighconnlimit', 'gridfreqlowconnlimit', 'gridfreqhighconnlimit',
+                    'modul', 'firmware', 'controlfirmware', 'serial'
+                ]
+            );
+            for (var sk in s) {
+                settings[sk] = s[sk];
+            }
+        }
+        return settings;
+    }
+
+    // Power limit result (response to CMD_SET_POWER_LIMIT)
+    // result 0xFE: value read back differs from requested value
+    if (port === 6) {
+        var limit = decode(bytes, [uint8, uint8, uint8], ['result', 'requested', 'readback']);
+        limit.text = (limit.result === 0xFE) ? "VerifyFailed" : modbus_code[limit.result];
+        return limit;
+    }
+
+    // Compact payload format (version 2) - header byte 0x2X
+    // Totals are differences to the last key frame if the delta flag is set.
+    if ((bytes[0] & 0xF0) === 0x20) {
+        var delta = (bytes[0] & 0x01) !== 0;
+        var res = (bytes.length === 2) ? {} : groupDecode(bytes.slice(2), port, delta).data;
+        res.modbus = modbus(bytes.slice(1, 2));
+        res.delta = delta;
+        return res;
+    }
+
+    // Grouped payload format (version 3) - header byte 0x3X
+    // Byte 2 is the group bitmap, bit n of the header is the delta flag of group n.
+    if ((bytes[0] & 0xF0) === 0x30) {
+        var groups = bytes[2];
+        var offset = 3;
+        var merged = { "modbus": modbus(bytes.slice(1, 2)), "groups": groups };
+        for (var g = 1; g <= 3; g++) {
+            if ((groups & (1 << (g - 1))) && (bytes.length > offset)) {
+                var grp = groupDecode(bytes.slice(offset), g, (bytes[0] & (1 << (g - 1))) !== 0);
+                offset += grp.size;
+                for (var key in grp.data) {
+                    merged[key] = grp.data[key];
+                }
+            }
+        }
+        return merged;
+    }
+
     if (bytes.length === 1) {
         return { "modbus": modbus(bytes) };
     }
@@ -0,0 +1,381 @@
+///////////////////////////////////////////////////////////////////////////////
+// acquisition.cpp
+//
+// Non-blocking Modbus data acquisition
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Added snapshot publishing and acquisition task (ACQ_TASK)
+//          Acquisition for multiple data groups
+//          Added execution time measurement (ENABLE_TIMING)
+//          Added runtime statistics
+//          Added polling of multiple slaves (MODBUS_SLAVES)
+//          Added aggregation of Modbus data (PAYLOAD_AGG)
+//          Added background refresh of cached inverter settings
+//          Added power limit write path (read, write, verify)
+//          Added serial output of register data (ENABLE_JSON)
+//          Modbus interface is initialized once (see modbusSession.h);
+//          exponential retry delays, inverters not responding are skipped
+//          Added grid capture polls (CAPTURE_EN)
+//          Failed capture polls do not cause a backoff of the slave
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "acquisition.h"
+#include "payload.h"
+#include "gridCapture.h"
+
+SnapshotBuffer slaveSnapshot[MAX_SLAVES];
+SnapshotBuffer &modbusSnapshot = slaveSnapshot[0];
+
+void ModbusAcquisition::start(uint8_t groups)
+{
+    m_groups  = groups;
+    m_retries = 0;
+    m_slave   = 0;
+    m_limitDone    = false;
+    m_settingsDone = false;
+    if (groups & ~PAYLOAD_GROUP_CAPTURE) {
+        m_first = (m_first + 1) % NUM_SLAVES;
+    } else {
+        // power limit or grid capture only - first slave
+        m_slave = (NUM_SLAVES - m_first) % NUM_SLAVES;
+    }
+    m_result  = growattIF::Continue;
+    m_state   = ACQ_INIT;
+    m_tBegin  = millis();
+    TIMING_RESTART(m_tAcq);
+}
+
+void ModbusAcquisition::wait(uint32_t ms, State next)
+{
+    m_tStart = millis();
+    m_tWait  = ms;
+    m_next   = next;
+    m_state  = ACQ_WAIT;
+}
+
+void ModbusAcquisition::publish(uint8_t idx)
+{
+    if (m_result == growattIF::Success) {
+        m_snap.data      = growattInterface.modbusdata;
+        m_snap.timestamp = millis();
+        #if defined(PAYLOAD_AGG)
+            if (idx == 0)
+                aggregator.add(m_snap.data, m_snap.timestamp);
+        #endif
+    } else {
+        // keep last good data of this slave
+        slaveSnapshot[idx].read(m_snap);
+    }
+    m_snap.result = m_result;
+    slaveSnapshot[idx].publish(m_snap);
+}
+
+#if defined(ENABLE_JSON)
+// Write decoded register data to Serial (free if Modbus uses RS485)
+void ModbusAcquisition::bridge(bool holding)
+{
+    static uint8_t buf[JSON_BUF_SIZE];
+
+    if (!growattIF::isRS485())
+        return;
+    #if defined(ENABLE_CBOR)
+        size_t len = growattInterface.serialize(holding, FMT_CBOR, buf, sizeof(buf));
+    #else
+        size_t len = growattInterface.serialize(holding, FMT_JSON, buf, sizeof(buf));
+    #endif
+    if (len == 0) {
+        log_w("JSON_BUF_SIZE too small");
+        return;
+    }
+    Serial.write(buf, len);
+    #if !defined(ENABLE_CBOR)
+        Serial.println();
+    #endif
+}
+#endif
+
+// Grid capture poll (see gridCapture.h)
+bool ModbusAcquisition::isCapture(void)
+{
+    return m_groups == PAYLOAD_GROUP_CAPTURE;
+}
+
+// Select next slave; returns true if all slaves are done
+bool ModbusAcquisition::nextSlave(void)
+{
+    if (++m_slave < NUM_SLAVES) {
+        m_retries = 0;
+        if (!startSlave()) {
+            wait(max(modbusSession.settleTime(), (uint32_t)MODBUS_REQ_DELAY), ACQ_REQUEST);
+            return false;
+        }
+        return nextSlave();
+    }
+    m_state = ACQ_DONE;
+    stats_add(rtStats.acqTime, millis() - m_tBegin);
+    TIMING_END(TIMING_ACQ, m_tAcq);
+    return true;
+}
+
+// Select current slave; returns true if it is skipped (backoff after failure)
+bool ModbusAcquisition::startSlave(void)
+{
+    uint8_t idx = slaveIdx();
+
+    if (modbusSession.isBackoff(idx)) {
+        log_d("Slave %u - skipped (backoff)", modbusSlaves[idx]);
+        m_result = modbusSession.lastError(idx);
+        publish(idx);
+        return true;
+    }
+    growattInterface.setSlave(modbusSlaves[idx]);
+    return false;
+}
+
+// Execute pending jobs of first slave after its input registers have been read;
+// returns true if acquisition has been completed
+bool ModbusAcquisition::jobs(void)
+{
+    if (slaveIdx() == 0) {
+        if (!m_limitDone && powerLimit.isDue()) {
+            m_limitDone = true;
+            m_limit     = powerLimit.target();
+            wait(MODBUS_REQ_DELAY, ACQ_LIMIT);
+            return false;
+        }
+        if (m_groups && !m_settingsDone && settingsCache.isDue()) {
+            m_settingsDone = true;
+            wait(MODBUS_REQ_DELAY, ACQ_SETTINGS);
+            return false;
+        }
+    }
+    if (m_groups == 0) {
+        m_state = ACQ_DONE;
+        return true;
+    }
+    return nextSlave();
+}
+
+// Finish power limit request
+void ModbusAcquisition::limitDone(uint8_t result, uint16_t value)
+{
+    if (result != growattIF::Success && result != PowerLimit::VerifyFailed) {
+        stats_inc(rtStats.mbErrors);
+    }
+    powerLimit.done(m_limit, result, value);
+    if (result == growattIF::Success) {
+        // cached settings contain maxoutputactivepp
+        settingsCache.invalidate();
+    }
+}
+
+bool ModbusAcquisition::step(void)
+{
+    switch (m_state) {
+        case ACQ_INIT: {
+            // initializes interface only once or after failure
+            uint32_t settle = modbusSession.open();
+            if (m_groups == 0) {
+                // power limit only (not affected by backoff)
+                growattInterface.setSlave(modbusSlaves[slaveIdx()]);
+                m_limitDone = true;
+                m_limit     = powerLimit.target();
+                wait(settle, ACQ_LIMIT);
+                break;
+            }
+            plan_payload(m_groups);
+            if (isCapture()) {
+                if (modbusSession.isBackoff(slaveIdx())) {
+                    m_state = ACQ_DONE;
+                    return true;
+                }
+                growattInterface.setSlave(modbusSlaves[slaveIdx()]);
+            } else if (startSlave()) {
+                return nextSlave();
+            }
+            wait(settle, ACQ_REQUEST);
+            break;
+        }
+
+        case ACQ_WAIT:
+            if (millis() - m_tStart >= m_tWait) {
+                m_state = m_next;
+            }
+            break;
+
+        case ACQ_REQUEST:
+            m_result = growattInterface.ReadInputRegisters();
+            log_d("ReadInputRegisters: 0x%02x", m_result);
+            stats_inc(rtStats.mbRequests);
+            #if defined(CAPTURE_EN)
+                if (isCapture() && (m_result != growattIF::Continue)) {
+                    // single attempt - missed samples are marked by gridCapture;
+                    // a failed poll does not affect the slave's session health
+                    // (no backoff of the regular acquisition)
+                    if (m_result == growattIF::Success) {
+                        modbusSession.result(slaveIdx(), m_result);
+                        gridCapture.add(growattInterface.modbusdata, millis());
+                    } else {
+                        stats_inc(rtStats.mbErrors);
+                    }
+                    m_state = ACQ_DONE;
+                    return true;
+                }
+            #endif
+            if (m_result == growattIF::Success) {
+                modbusSession.result(slaveIdx(), m_result);
+                publish(slaveIdx());
+                #if defined(ENABLE_JSON)
+                    bridge(false);
+                #endif
+                return jobs();
+            }
+            if (m_result == growattIF::Continue) {
+                stats_inc(rtStats.mbContinue);
+                wait(MODBUS_REQ_DELAY, ACQ_REQUEST);
+                break;
+            }
+            log_e("Slave %u - Error: %s", modbusSlaves[slaveIdx()], growattInterface.sendModbusError(m_result).c_str());
+            stats_inc(rtStats.mbErrors);
+            if (m_result == ModbusTransport::ku8MBResponseTimedOut) {
+                stats_inc(rtStats.mbTimeouts);
+            } else if (m_result == ModbusTransport::ku8MBInvalidCRC) {
+                stats_inc(rtStats.mbCrcErrors);
+            }
+            if (++m_retries >= modbusSession.attempts(slaveIdx())) {
+                stats_inc(rtStats.acqFailed);
+                modbusSession.result(slaveIdx(), m_result);
+                publish(slaveIdx());
+                return nextSlave();
+            }
+            stats_inc(rtStats.mbRetries);
+            wait(ModbusSession::retryDelay(m_retries - 1), ACQ_REQUEST);
+            break;
+
+        case ACQ_SETTINGS: {
+            // no retries - refresh is tried again with a later acquisition
+            uint8_t result = growattInterface.ReadHoldingRegisters();
+            log_d("ReadHoldingRegisters: 0x%02x", result);
+            stats_inc(rtStats.mbRequests);
+            if (result == growattIF::Continue) {
+                stats_inc(rtStats.mbContinue);
+                wait(MODBUS_REQ_DELAY, ACQ_SETTINGS);
+                break;
+            }
+            if (result != growattIF::Success) {
+                stats_inc(rtStats.mbErrors);
+            }
+            #if defined(ENABLE_JSON)
+                if (result == growattIF::Success)
+                    bridge(true);
+            #endif
+            settingsCache.update(result, growattInterface.modbussettings);
+            return jobs();
+        }
+
+        case ACQ_LIMIT: {
+            // write only if value differs (EEPROM write cycles)
+            uint16_t value;
+            uint8_t  result = growattInterface.readRegister(growattIF::regMaxOutputActive, value);
+            stats_inc(rtStats.mbRequests);
+            log_d("Power limit: %u %% -> %u %% (0x%02x)", value, m_limit, result);
+            if ((result != growattIF::Success) || (value == m_limit)) {
+                limitDone(result, value);
+                return jobs();
+            }
+            wait(MODBUS_REQ_DELAY, ACQ_WRITE);
+            break;
+        }
+
+        case ACQ_WRITE: {
+            uint8_t result = growattInterface.writeRegister(growattIF::regMaxOutputActive, m_limit);
+            stats_inc(rtStats.mbRequests);
+            if (result != growattIF::Success) {
+                limitDone(result, 0);
+                return jobs();
+            }
+            wait(MODBUS_REQ_DELAY, ACQ_VERIFY);
+            break;
+        }
+
+        case ACQ_VERIFY: {
+            uint16_t value;
+            uint8_t  result = growattInterface.readRegister(growattIF::regMaxOutputActive, value);
+            stats_inc(rtStats.mbRequests);
+            if ((result == growattIF::Success) && (value != m_limit)) {
+                result = PowerLimit::VerifyFailed;
+            }
+            limitDone(result, value);
+            return jobs();
+        }
+
+        default:
+            break;
+    }
+    return false;
+}
+
+#if defined(ACQ_TASK)
+static void acqTask(void *pvParameters)
+{
+    ModbusAcquisition acq;
+    TickType_t lastWake = xTaskGetTickCount();
+
+    for (;;) {
+        acq.start(PAYLOAD_GROUPS_ALL);
+        while (!acq.step()) {
+            vTaskDelay(1);
+        }
+        #if defined(CAPTURE_EN)
+            // capture polls until next regular acquisition
+            while (xTaskGetTickCount() - lastWake < pdMS_TO_TICKS(UPDATE_MODBUS * 1000)) {
+                if (gridCapture.isDue()) {
+                    acq.start(PAYLOAD_GROUP_CAPTURE);
+                    while (!acq.step()) {
+                        vTaskDelay(1);
+                    }
+                }
+                vTaskDelay(1);
+            }
+        #endif
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(UPDATE_MODBUS * 1000));
+    }
+}
+
+void startAcqTask(void)
+{
+    xTaskCreatePinnedToCore(acqTask, "acq", ACQ_TASK_STACK, NULL, ACQ_TASK_PRIO, NULL, ACQ_TASK_CORE);
+}
+#endif
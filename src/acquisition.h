@@ -0,0 +1,205 @@
+///////////////////////////////////////////////////////////////////////////////
+// acquisition.h
+//
+// Non-blocking Modbus data acquisition
+//
+// Resumable state machine which reads the Growatt input registers required
+// for an uplink - one Modbus transaction per step() call. Delays between
+// requests and before retries are implemented as timeouts, so the LoRaWAN
+// stack keeps being serviced while data is acquired.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Added snapshot publishing and acquisition task (ACQ_TASK)
+//          Acquisition for multiple data groups
+//          Added execution time measurement (ENABLE_TIMING)
+//          Added runtime statistics
+//          Added polling of multiple slaves (MODBUS_SLAVES)
+//          Added aggregation of Modbus data (PAYLOAD_AGG)
+//          Added background refresh of cached inverter settings
+//          Added power limit write path (read, write, verify)
+//          Modbus interface initialization, retries and backoff are
+//          handled by modbusSession
+//          Added grid capture polls (CAPTURE_EN)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef ACQUISITION_H
+#define ACQUISITION_H
+
+#include "Arduino.h"
+#include "settings.h"
+#include "growattInterface.h"
+#include "snapshot.h"
+#include "timing.h"
+#include "stats.h"
+#include "aggregator.h"
+#include "settingsCache.h"
+#include "powerLimit.h"
+#include "modbusSession.h"
+
+#define ACQ_TASK_STACK      4096    // acquisition task stack size
+#define ACQ_TASK_PRIO       1       // acquisition task priority
+#define ACQ_TASK_CORE       0       // acquisition task core (Arduino loop() runs on core 1)
+
+/// Slave IDs of all inverters
+static constexpr uint8_t modbusSlaves[] = MODBUS_SLAVES;
+
+/// Number of inverters
+#define NUM_SLAVES (sizeof(modbusSlaves) / sizeof(modbusSlaves[0]))
+
+static_assert(NUM_SLAVES <= MAX_SLAVES, "MODBUS_SLAVES: too many slaves (see MAX_SLAVES)");
+
+/*!
+ * \class ModbusAcquisition
+ *
+ * \brief Resumable Modbus acquisition state machine
+ */
+class ModbusAcquisition {
+public:
+    /// Acquisition state
+    enum State : uint8_t {
+        ACQ_IDLE,       //!< no acquisition in progress
+        ACQ_INIT,       //!< open Modbus session
+        ACQ_WAIT,       //!< wait until m_tWait has expired
+        ACQ_REQUEST,    //!< send next request and decode response
+        ACQ_SETTINGS,   //!< read holding registers (cached settings refresh)
+        ACQ_LIMIT,      //!< read power limit register
+        ACQ_WRITE,      //!< write power limit register
+        ACQ_VERIFY,     //!< read back power limit register
+        ACQ_DONE        //!< acquisition completed, result available
+    };
+
+    ModbusAcquisition() {};
+
+    /*!
+     * \brief Start acquisition of data for uplink data groups
+     *
+     * \param groups group bitmap (see PAYLOAD_GROUP());
+     *               0: only execute pending power limit request;
+     *               PAYLOAD_GROUP_CAPTURE: single request to first slave,
+     *               sample is added to gridCapture (no publishing, no jobs)
+     */
+    void start(uint8_t groups);
+
+    /*!
+     * \brief Advance state machine
+     *
+     * \details
+     *     Should be called from loop(). Does at most one Modbus transaction
+     *     per call and never waits. All slaves are read in round-robin order
+     *     (starting with the next slave in each cycle), the result of each
+     *     slave is published to slaveSnapshot[].
+     *     After the input registers of the first slave, a pending power limit
+     *     request is executed and the cached inverter settings are refreshed
+     *     (if due).
+     *
+     * \returns true once when acquisition has been completed
+     */
+    bool step(void);
+
+    /// Acquisition in progress
+    bool isBusy(void) {
+        return (m_state != ACQ_IDLE) && (m_state != ACQ_DONE);
+    }
+
+    /// Uplink data groups of current/last acquisition
+    uint8_t getGroups(void) {
+        return m_groups;
+    }
+
+    /// Result of last acquisition (growattIF::Success or Modbus error code)
+    uint8_t getResult(void) {
+        return m_result;
+    }
+
+private:
+    void wait(uint32_t ms, State next);
+
+    void publish(uint8_t idx);
+#if defined(ENABLE_JSON)
+    void bridge(bool holding);
+#endif
+
+    bool nextSlave(void);
+
+    bool startSlave(void);
+
+    bool jobs(void);
+
+    void limitDone(uint8_t result, uint16_t value);
+
+    bool isCapture(void);
+
+    /// Index of current slave in modbusSlaves[]
+    uint8_t slaveIdx(void) {
+        return (m_first + m_slave) % NUM_SLAVES;
+    }
+
+    Snapshot m_snap;                //!< last published snapshot
+    State    m_state = ACQ_IDLE;    //!< current state
+    State    m_next;                //!< state after ACQ_WAIT
+    uint8_t  m_groups;              //!< uplink data groups
+    uint8_t  m_result;              //!< result of last request
+    uint8_t  m_retries;             //!< number of retries
+    uint8_t  m_first = 0;           //!< index of first slave in this cycle
+    uint8_t  m_slave;               //!< no. of slaves done in this cycle
+    uint8_t  m_limit;               //!< power limit being written
+    bool     m_limitDone;           //!< power limit request handled in this cycle
+    bool     m_settingsDone;        //!< settings refresh handled in this cycle
+    uint32_t m_tStart;              //!< start of wait period
+    uint32_t m_tBegin;              //!< start of acquisition
+#if defined(ENABLE_TIMING)
+    int64_t  m_tAcq;                //!< start of acquisition [us]
+#endif
+    uint32_t m_tWait;               //!< wait period in ms
+};
+
+/// Latest Modbus register snapshot of each slave
+extern SnapshotBuffer slaveSnapshot[MAX_SLAVES];
+
+/// Latest Modbus register snapshot of first slave
+extern SnapshotBuffer &modbusSnapshot;
+
+#if defined(ACQ_TASK)
+/*!
+ * \brief Start acquisition task
+ *
+ * \details
+ *     The task reads the input registers for all uplink ports every
+ *     UPDATE_MODBUS seconds and publishes them to modbusSnapshot.
+ */
+void startAcqTask(void);
+#endif
+
+#endif
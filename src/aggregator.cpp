@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////////////
+// aggregator.cpp
+//
+// Streaming aggregation of Modbus data between uplinks
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "aggregator.h"
+
+#if defined(PAYLOAD_AGG)
+
+Aggregator aggregator;
+
+// Update min/max/sum of channel
+static void update(AggChannel &ch, float value, bool first)
+{
+    if (first || (value < ch.min))
+        ch.min = value;
+    if (first || (value > ch.max))
+        ch.max = value;
+    ch.sum += value;
+}
+
+void Aggregator::add(const modbus_input_registers &data, uint32_t time)
+{
+    // Samples are added by the acquisition task and taken from loop()
+    portENTER_CRITICAL(&m_mux);
+    bool first = (m_sum.count == 0);
+
+    update(m_sum.outputpower, data.outputpower, first);
+    update(m_sum.pv1power, data.pv1power, first);
+    update(m_sum.gridvoltage, data.gridvoltage, first);
+    if (m_sum.count < UINT16_MAX)
+        m_sum.count++;
+
+    if (m_valid) {
+        // trapezoidal rule
+        uint32_t dt = time - m_tLast;
+        m_sum.duration     += dt;
+        m_sum.outputenergy += (m_outLast + data.outputpower) / 2 * dt / 3600000.0f;
+        m_sum.pv1energy    += (m_pv1Last + data.pv1power) / 2 * dt / 3600000.0f;
+    }
+    m_tLast   = time;
+    m_outLast = data.outputpower;
+    m_pv1Last = data.pv1power;
+    m_valid   = true;
+    portEXIT_CRITICAL(&m_mux);
+}
+
+void Aggregator::take(AggSummary &sum)
+{
+    portENTER_CRITICAL(&m_mux);
+    sum   = m_sum;
+    m_sum = {};
+    portEXIT_CRITICAL(&m_mux);
+}
+
+#endif
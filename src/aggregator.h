@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////
+// aggregator.h
+//
+// Streaming aggregation of Modbus data between uplinks
+//
+// Every Modbus data sample (UPDATE_MODBUS cadence) updates min/max/mean
+// of selected channels and integrates power over time (trapezoidal rule).
+// Memory is constant per channel. The summary is taken (and the aggregator
+// restarted) when an uplink is encoded.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AGGREGATOR_H
+#define AGGREGATOR_H
+
+#include "Arduino.h"
+#include "settings.h"
+#include "growattRegisters.h"
+
+/// Min/max/sum of one channel
+struct AggChannel {
+    float min;                  //!< minimum
+    float max;                  //!< maximum
+    float sum;                  //!< sum of samples
+};
+
+/// Aggregated data of one uplink interval
+struct AggSummary {
+    uint16_t   count;           //!< no. of samples
+    uint32_t   duration;        //!< integration time [ms]
+    AggChannel outputpower;     //!< output power [W]
+    AggChannel pv1power;        //!< PV1 power [W]
+    AggChannel gridvoltage;     //!< grid voltage [V]
+    float      outputenergy;    //!< output energy [Wh]
+    float      pv1energy;       //!< PV1 energy [Wh]
+};
+
+/*!
+ * \class Aggregator
+ *
+ * \brief Streaming min/max/mean and energy integration
+ */
+class Aggregator {
+public:
+    Aggregator() {};
+
+    /*!
+     * \brief Add sample
+     *
+     * \param data     input register data
+     * \param time     sample time [ms]
+     */
+    void add(const modbus_input_registers &data, uint32_t time);
+
+    /*!
+     * \brief Get summary and start new interval
+     *
+     * \param sum      summary of samples since last call
+     */
+    void take(AggSummary &sum);
+
+private:
+    AggSummary   m_sum = {};            //!< current interval
+    bool         m_valid = false;       //!< previous sample is valid
+    uint32_t     m_tLast;               //!< time of previous sample
+    float        m_outLast;             //!< previous output power
+    float        m_pv1Last;             //!< previous PV1 power
+    portMUX_TYPE m_mux = portMUX_INITIALIZER_UNLOCKED;
+};
+
+/// Aggregator of (first) inverter's data
+extern Aggregator aggregator;
+
+#endif
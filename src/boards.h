@@ -0,0 +1,239 @@
+///////////////////////////////////////////////////////////////////////////////
+// boards.h
+//
+// LoRaWAN Node for Growatt PV-Inverter Data Interface
+//
+// Board profiles - pin assignments of LoRa radio, Modbus interface and
+// debug port
+//
+// The ARDUINO_* defines are set by selecting the appropriate board (and board
+// variant, if applicable) in the Arduino IDE; FIREBEETLE_ESP32_COVER_LORA and
+// LORAWAN_NODE are selected in settings.h.
+// To add a board, add one profile declaration to the list below. The profile
+// is checked at compile time (see static_asserts at the end of this file).
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created from pin definitions in settings.h and growatt2lorawan.ino
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOARDS_H
+#define BOARDS_H
+
+#include "Arduino.h"
+#include "settings.h"
+
+#define PIN_NONE    -1      //!< pin not used / not connected
+
+#if defined(SOC_GPIO_PIN_COUNT)
+    #define BOARD_GPIO_NUM  SOC_GPIO_PIN_COUNT
+#else
+    #define BOARD_GPIO_NUM  40
+#endif
+
+/// Board profile
+struct BoardProfile {
+    const char *name;       //!< board name
+
+    // LoRa radio
+    int8_t lmicNss;         //!< SPI chip select
+    int8_t lmicRst;         //!< reset
+    int8_t lmicDio0;        //!< DIO0
+    int8_t lmicDio1;        //!< DIO1
+    int8_t lmicDio2;        //!< DIO2
+
+    // Modbus interface
+    int8_t interfaceSel;    //!< Modbus interface select (0: USB / 1: RS485)
+    int8_t max485De;        //!< DE pin on the TTL to RS485 converter
+    int8_t max485ReNeg;     //!< RE pin on the TTL to RS485 converter
+    int8_t max485Rx;        //!< RO pin on the TTL to RS485 converter
+    int8_t max485Tx;        //!< DI pin on the TTL to RS485 converter
+
+    // Debug port (Modbus via USB only)
+    int8_t debugTx;         //!< Serial port output to   USB converter
+    int8_t debugRx;         //!< Serial port input  from USB converter
+};
+
+#if defined(ARDUINO_TTGO_LoRa32_V1)
+    // https://github.com/espressif/arduino-esp32/blob/master/variants/ttgo-lora32-v1/pins_arduino.h
+    // http://www.lilygo.cn/prod_view.aspx?TypeId=50003&Id=1130&FId=t3:50003:3
+    // https://github.com/Xinyuan-LilyGo/TTGO-LoRa-Series
+    // https://github.com/LilyGO/TTGO-LORA32/blob/master/schematic1in6.pdf
+    static constexpr BoardProfile board = {
+        .name = "TTGO LoRa32 V1",
+        .lmicNss = LORA_CS, .lmicRst = LORA_RST, .lmicDio0 = LORA_IRQ, .lmicDio1 = 33, .lmicDio2 = PIN_NONE,
+        .interfaceSel = 13, .max485De = 10, .max485ReNeg = 2, .max485Rx = 27, .max485Tx = 9,
+        .debugTx = 5, .debugRx = PIN_NONE
+    };
+
+#elif defined(ARDUINO_TTGO_LoRa32_V2)
+    // https://github.com/espressif/arduino-esp32/blob/master/variants/ttgo-lora32-v2/pins_arduino.h
+    static constexpr BoardProfile board = {
+        .name = "TTGO LoRa32 V2",
+        .lmicNss = LORA_CS, .lmicRst = LORA_RST, .lmicDio0 = LORA_IRQ, .lmicDio1 = 33, .lmicDio2 = PIN_NONE,
+        .interfaceSel = 13, .max485De = 10, .max485ReNeg = 2, .max485Rx = 27, .max485Tx = 9,
+        .debugTx = 5, .debugRx = PIN_NONE
+    };
+    #pragma message("LoRa DIO1 must be wired to GPIO33 manually!")
+
+#elif defined(ARDUINO_TTGO_LoRa32_v21new)
+    // https://github.com/espressif/arduino-esp32/blob/master/variants/ttgo-lora32-v21new/pins_arduino.h
+    static constexpr BoardProfile board = {
+        .name = "TTGO LoRa32 V2.1",
+        .lmicNss = LORA_CS, .lmicRst = LORA_RST, .lmicDio0 = LORA_IRQ, .lmicDio1 = LORA_D1, .lmicDio2 = LORA_D2,
+        .interfaceSel = 13, .max485De = 14, .max485ReNeg = 2, .max485Rx = 15, .max485Tx = 12,
+        .debugTx = 0, .debugRx = 4
+    };
+
+#elif defined(ARDUINO_heltec_wireless_stick) || defined(ARDUINO_heltec_wifi_lora_32_V2)
+    // https://github.com/espressif/arduino-esp32/blob/master/variants/heltec_wireless_stick/pins_arduino.h
+    // https://github.com/espressif/arduino-esp32/tree/master/variants/heltec_wifi_lora_32_V2/pins_ardiono.h
+    static constexpr BoardProfile board = {
+        .name = "Heltec WiFi LoRa 32 V2 / Wireless Stick",
+        .lmicNss = SS, .lmicRst = RST_LoRa, .lmicDio0 = DIO0, .lmicDio1 = DIO1, .lmicDio2 = DIO2,
+        .interfaceSel = 13, .max485De = 10, .max485ReNeg = 2, .max485Rx = 27, .max485Tx = 9,
+        .debugTx = 5, .debugRx = PIN_NONE
+    };
+
+#elif defined(ARDUINO_ADAFRUIT_FEATHER_ESP32S2)
+    static constexpr BoardProfile board = {
+        .name = "Adafruit Feather ESP32-S2",
+        .lmicNss = 6, .lmicRst = 9, .lmicDio0 = 5, .lmicDio1 = 11, .lmicDio2 = PIN_NONE,
+        .interfaceSel = 13, .max485De = 10, .max485ReNeg = 12, .max485Rx = 38, .max485Tx = 39,
+        .debugTx = 14, .debugRx = PIN_NONE
+    };
+    #pragma message("ARDUINO_ADAFRUIT_FEATHER_ESP32S2 defined; assuming RFM95W FeatherWing will be used")
+    #pragma message("Required wiring: E to IRQ, D to CS, C to RST, A to DI01")
+    #pragma message("BLE is not available!")
+
+#elif defined(ARDUINO_FEATHER_ESP32)
+    // https://github.com/espressif/arduino-esp32/blob/master/variants/feather_esp32/pins_arduino.h
+    static constexpr BoardProfile board = {
+        .name = "Adafruit Feather ESP32",
+        .lmicNss = 14, .lmicRst = 27, .lmicDio0 = 32, .lmicDio1 = 33, .lmicDio2 = PIN_NONE,
+        .interfaceSel = 13, .max485De = 4, .max485ReNeg = 15, .max485Rx = 22, .max485Tx = 23,
+        .debugTx = 12, .debugRx = 21
+    };
+    #pragma message("NOT TESTED!!!")
+    #pragma message("ARDUINO_ADAFRUIT_FEATHER_ESP32 defined; assuming RFM95W FeatherWing will be used")
+    #pragma message("Required wiring: A to RST, B to DIO1, D to DIO0, E to CS")
+
+#elif defined(FIREBEETLE_ESP32_COVER_LORA)
+    // https://wiki.dfrobot.com/FireBeetle_ESP32_IOT_Microcontroller(V3.0)__Supports_Wi-Fi_&_Bluetooth__SKU__DFR0478
+    // https://wiki.dfrobot.com/FireBeetle_Covers_LoRa_Radio_868MHz_SKU_TEL0125
+    static constexpr BoardProfile board = {
+        .name = "FireBeetle ESP32 + FireBeetle Cover LoRa",
+        .lmicNss = 27, .lmicRst = 25, .lmicDio0 = 26, .lmicDio1 = 9, .lmicDio2 = PIN_NONE,
+        .interfaceSel = 17, .max485De = 10, .max485ReNeg = 13, .max485Rx = 5, .max485Tx = 2,
+        .debugTx = 4, .debugRx = 16
+    };
+    #pragma message("FIREBEETLE_ESP32_COVER_LORA defined; assuming FireBeetle ESP32 with FireBeetle Cover LoRa will be used")
+    #pragma message("Required wiring: D2 to RESET, D3 to DIO0, D4 to CS, D5 to DIO1")
+
+#elif defined(LORAWAN_NODE)
+    // LoRaWAN_Node board
+    // https://github.com/matthias-bs/LoRaWAN_Node
+    static constexpr BoardProfile board = {
+        .name = "LoRaWAN_Node",
+        .lmicNss = 14, .lmicRst = 12, .lmicDio0 = 4, .lmicDio1 = 16, .lmicDio2 = 17,
+        .interfaceSel = 13, .max485De = 10, .max485ReNeg = 2, .max485Rx = 27, .max485Tx = 9,
+        .debugTx = 5, .debugRx = 26
+    };
+    #pragma message("LORAWAN_NODE defined; assuming LoRaWAN_Node board will be used")
+
+#else
+    // for generic CI target ESP32:ESP32:ESP32
+    static constexpr BoardProfile board = {
+        .name = "generic ESP32",
+        .lmicNss = 14, .lmicRst = 12, .lmicDio0 = 4, .lmicDio1 = 16, .lmicDio2 = 17,
+        .interfaceSel = 13, .max485De = 10, .max485ReNeg = 2, .max485Rx = 27, .max485Tx = 9,
+        .debugTx = 5, .debugRx = 26
+    };
+    #pragma message("Unknown board; please select one in the Arduino IDE or in settings.h or create your own!")
+
+#endif
+
+//
+// Compile-time checks of the selected board profile
+//
+
+/// Pin is a valid GPIO number
+constexpr bool boardPinValid(int8_t pin) {
+    return (pin >= 0) && (pin < BOARD_GPIO_NUM);
+}
+
+/// Pin can be used as output
+constexpr bool boardPinOutput(int8_t pin) {
+    #if defined(CONFIG_IDF_TARGET_ESP32)
+        // GPIO34...39 are input only
+        return boardPinValid(pin) && (pin < 34);
+    #else
+        return boardPinValid(pin);
+    #endif
+}
+
+/// Pin is not assigned to any other function in board profile
+constexpr bool boardPinUnique(int8_t pin, const BoardProfile &b) {
+    return (pin == PIN_NONE) || (
+        (pin == b.lmicNss)      + (pin == b.lmicRst)     + (pin == b.lmicDio0) +
+        (pin == b.lmicDio1)     + (pin == b.lmicDio2)    +
+        (pin == b.interfaceSel) + (pin == b.max485De)    + (pin == b.max485ReNeg) +
+        (pin == b.max485Rx)     + (pin == b.max485Tx)    +
+        (pin == b.debugTx)      + (pin == b.debugRx)     == 1);
+}
+
+static_assert(boardPinOutput(board.lmicNss) && boardPinOutput(board.lmicRst),
+              "board: invalid LoRa NSS/RST pin");
+static_assert(boardPinValid(board.lmicDio0) && boardPinValid(board.lmicDio1),
+              "board: invalid LoRa DIO0/DIO1 pin");
+static_assert((board.lmicDio2 == PIN_NONE) || boardPinValid(board.lmicDio2),
+              "board: invalid LoRa DIO2 pin");
+static_assert(boardPinValid(board.interfaceSel) && boardPinValid(board.max485Rx),
+              "board: invalid interface select/RS485 RX pin");
+static_assert(boardPinOutput(board.max485De) && boardPinOutput(board.max485ReNeg) &&
+              boardPinOutput(board.max485Tx),
+              "board: RS485 DE/RE/TX pin must be an output");
+static_assert(boardPinOutput(board.debugTx),
+              "board: debug TX pin must be an output");
+static_assert((board.debugRx == PIN_NONE) || boardPinValid(board.debugRx),
+              "board: invalid debug RX pin");
+static_assert(boardPinUnique(board.lmicNss, board)      && boardPinUnique(board.lmicRst, board)  &&
+              boardPinUnique(board.lmicDio0, board)     && boardPinUnique(board.lmicDio1, board) &&
+              boardPinUnique(board.lmicDio2, board)     &&
+              boardPinUnique(board.interfaceSel, board) && boardPinUnique(board.max485De, board) &&
+              boardPinUnique(board.max485ReNeg, board)  && boardPinUnique(board.max485Rx, board) &&
+              boardPinUnique(board.max485Tx, board)     &&
+              boardPinUnique(board.debugTx, board)      && boardPinUnique(board.debugRx, board),
+              "board: pin assigned more than once");
+
+#endif
@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////////////
+// downlink.cpp
+//
+// Table-driven downlink command dispatcher
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "downlink.h"
+
+// Find command descriptor
+static const DownlinkCmd *lookup(const DownlinkCmd *table, uint8_t n, uint8_t opcode)
+{
+    for (uint8_t i = 0; i < n; i++) {
+        if (table[i].opcode == opcode)
+            return &table[i];
+    }
+    return nullptr;
+}
+
+uint8_t downlink_dispatch(const DownlinkCmd *table, uint8_t n, const uint8_t *buf, size_t len)
+{
+    #if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_VERBOSE
+        char hex[3 * 32 + 1];
+        size_t pos = 0;
+        for (size_t i = 0; (i < len) && (pos < sizeof(hex) - 3); i++) {
+            pos += snprintf(&hex[pos], sizeof(hex) - pos, "%02X ", buf[i]);
+        }
+        hex[pos] = '\0';
+        log_v("Data: %s%s", hex, (pos < 3 * len) ? "..." : "");
+    #endif
+
+    // validate frame
+    for (size_t i = 0; i < len; ) {
+        const DownlinkCmd *cmd = lookup(table, n, buf[i]);
+        if (!cmd) {
+            log_w("Unknown command 0x%02X - downlink ignored", buf[i]);
+            return 0;
+        }
+        if (i + cmd->len > len) {
+            log_w("Command 0x%02X truncated - downlink ignored", buf[i]);
+            return 0;
+        }
+        i += cmd->len;
+    }
+
+    // execute commands
+    uint8_t count = 0;
+    for (size_t i = 0; i < len; ) {
+        const DownlinkCmd *cmd = lookup(table, n, buf[i]);
+        if (cmd->handler(&buf[i])) {
+            count++;
+        } else {
+            log_w("Command 0x%02X: invalid argument", buf[i]);
+        }
+        i += cmd->len;
+    }
+    return count;
+}
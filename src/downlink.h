@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////////////////////////
+// downlink.h
+//
+// Table-driven downlink command dispatcher
+//
+// A downlink may contain several commands back to back, e.g.
+// [CMD_SET_SLEEP_INTERVAL, hi, lo, CMD_SET_HEARTBEAT, n, CMD_GET_CONFIG].
+// Each command is identified by its opcode (first byte) and has a fixed
+// length. The whole frame is validated before any command is executed.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DOWNLINK_H
+#define DOWNLINK_H
+
+#include "Arduino.h"
+
+/*!
+ * \brief Downlink command handler
+ *
+ * \param cmd      command bytes (cmd[0]: opcode, cmd[1]...: arguments)
+ *
+ * \returns false if arguments are invalid
+ */
+typedef bool (*DownlinkHandler)(const uint8_t *cmd);
+
+/// Downlink command descriptor
+struct DownlinkCmd {
+    uint8_t         opcode;     //!< command code
+    uint8_t         len;        //!< command length incl. opcode
+    DownlinkHandler handler;    //!< command handler
+};
+
+/*!
+ * \brief Execute all commands of a downlink frame
+ *
+ * The frame is rejected without executing any command if it contains
+ * an unknown opcode or a truncated command.
+ *
+ * \param table    command table
+ * \param n        no. of entries in command table
+ * \param buf      downlink payload
+ * \param len      downlink payload size
+ *
+ * \returns no. of commands executed successfully
+ */
+uint8_t downlink_dispatch(const DownlinkCmd *table, uint8_t n, const uint8_t *buf, size_t len);
+
+#endif
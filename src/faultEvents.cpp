@@ -0,0 +1,134 @@
+///////////////////////////////////////////////////////////////////////////////
+// faultEvents.cpp
+//
+// Fault and warning event queue
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "faultEvents.h"
+#include "growattInterface.h"
+
+FaultEvents faultEvents;
+
+/// Event queue - in RTC RAM to survive deep sleep
+struct EventState {
+    uint32_t   faultbitcode;                //!< faultbitcode of previous poll (0 after reset)
+    uint32_t   warningbitcode;              //!< warningbitcode of previous poll (0 after reset)
+    uint8_t    head;                        //!< index of oldest event
+    uint8_t    count;                       //!< no. of queued events
+    uint8_t    sent;                        //!< no. of events in uplink in progress
+    uint8_t    dropped;                     //!< no. of events dropped since last ACK
+    FaultEvent queue[EVENT_QUEUE_SIZE];     //!< event queue
+};
+
+RTC_DATA_ATTR static EventState eventState;
+
+bool FaultEvents::push(uint8_t type, uint8_t faultcode, uint32_t prev, uint32_t cur, uint32_t time)
+{
+    if (prev == cur)
+        return false;
+
+    log_i("Event: %s raised 0x%08X, cleared 0x%08X", (type == EVENT_TYPE_FAULT) ? "fault" : "warning",
+        cur & ~prev, prev & ~cur);
+
+    // queue full - drop newest event (older events may be in transit)
+    if (eventState.count == EVENT_QUEUE_SIZE) {
+        log_w("Event queue full");
+        if (eventState.dropped < UINT8_MAX)
+            eventState.dropped++;
+        return false;
+    }
+
+    FaultEvent &ev = eventState.queue[(eventState.head + eventState.count) % EVENT_QUEUE_SIZE];
+    ev.time      = time;
+    ev.type      = type;
+    ev.faultcode = faultcode;
+    ev.raised    = cur & ~prev;
+    ev.cleared   = prev & ~cur;
+    eventState.count++;
+    return true;
+}
+
+bool FaultEvents::update(const Snapshot &snap, uint32_t time)
+{
+    if (snap.result != growattIF::Success)
+        return false;
+
+    uint32_t fault     = snap.data.faultbitcode;
+    uint32_t warning   = snap.data.warningbitcode;
+    uint8_t  faultcode = snap.data.faultcode;
+
+    bool queued = false;
+    queued |= push(EVENT_TYPE_FAULT,   faultcode, eventState.faultbitcode,   fault,   time);
+    queued |= push(EVENT_TYPE_WARNING, faultcode, eventState.warningbitcode, warning, time);
+
+    eventState.faultbitcode   = fault;
+    eventState.warningbitcode = warning;
+    return queued;
+}
+
+uint8_t FaultEvents::encode(LoraEncoder &encoder, uint8_t max)
+{
+    uint8_t n = min(eventState.count, max);
+
+    encoder.writeUint8(n);
+    encoder.writeUint8(eventState.dropped);
+    for (uint8_t i = 0; i < n; i++) {
+        const FaultEvent &ev = eventState.queue[(eventState.head + i) % EVENT_QUEUE_SIZE];
+        encoder.writeUint32(ev.time);
+        encoder.writeUint8(ev.type);
+        encoder.writeUint8(ev.faultcode);
+        encoder.writeUint32(ev.raised);
+        encoder.writeUint32(ev.cleared);
+    }
+    eventState.sent = n;
+    return n;
+}
+
+void FaultEvents::ack(bool success)
+{
+    if (success) {
+        eventState.head    = (eventState.head + eventState.sent) % EVENT_QUEUE_SIZE;
+        eventState.count  -= eventState.sent;
+        eventState.dropped = 0;
+    }
+    eventState.sent = 0;
+}
+
+uint8_t FaultEvents::pending(void)
+{
+    return eventState.count;
+}
@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////
+// faultEvents.h
+//
+// Fault and warning event queue
+//
+// faultbitcode and warningbitcode are compared with the values of the
+// previous poll; each change is queued as a timestamped event record with
+// the bits raised and cleared. The queue is kept in RTC RAM across deep
+// sleep and is sent on port PAYLOAD_PORT_EVENTS ahead of the periodic
+// uplinks. Events are removed from the queue when the (confirmed) uplink
+// has been acknowledged.
+//
+// Event payload (port PAYLOAD_PORT_EVENTS):
+// byte 0: no. of records
+// byte 1: no. of events dropped due to queue overflow (since last ACK)
+// per record (little endian):
+// uint32  timestamp (UNIX time)
+// uint8   type (0: fault, 1: warning)
+// uint8   faultcode
+// uint32  bits raised
+// uint32  bits cleared
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef FAULT_EVENTS_H
+#define FAULT_EVENTS_H
+
+#include "Arduino.h"
+#include <LoraMessage.h>
+#include "settings.h"
+#include "snapshot.h"
+
+#define EVENT_TYPE_FAULT    0           // faultbitcode changed
+#define EVENT_TYPE_WARNING  1           // warningbitcode changed
+#define EVENT_SIZE          14          // size of encoded event record in bytes
+
+/// Fault/warning event
+struct FaultEvent {
+    uint32_t time;                      //!< timestamp (UNIX time)
+    uint8_t  type;                      //!< event type (EVENT_TYPE_*)
+    uint8_t  faultcode;                 //!< faultcode at time of event
+    uint32_t raised;                    //!< bits raised
+    uint32_t cleared;                   //!< bits cleared
+};
+
+/*!
+ * \class FaultEvents
+ *
+ * \brief Edge detection of fault/warning bitmaps and event queue
+ */
+class FaultEvents {
+public:
+    FaultEvents() {};
+
+    /*!
+     * \brief Compare fault/warning bitmaps with previous poll
+     *
+     * May be called repeatedly with the same snapshot. After reset,
+     * bits already set in the first valid snapshot are reported as raised.
+     *
+     * \param snap     Modbus snapshot
+     * \param time     timestamp (UNIX time)
+     *
+     * \returns true if new events have been queued
+     */
+    bool update(const Snapshot &snap, uint32_t time);
+
+    /*!
+     * \brief Encode oldest events
+     *
+     * The events remain queued until ack() is called.
+     *
+     * \param encoder  LoRaWAN payload encoder
+     * \param max      max. no. of records
+     *
+     * \returns no. of records
+     */
+    uint8_t encode(LoraEncoder &encoder, uint8_t max);
+
+    /*!
+     * \brief Remove events sent by the last encode()
+     *
+     * \param success  uplink has been acknowledged
+     */
+    void ack(bool success);
+
+    /// No. of queued events
+    uint8_t pending(void);
+
+private:
+    bool push(uint8_t type, uint8_t faultcode, uint32_t prev, uint32_t cur, uint32_t time);
+};
+
+/// Fault/warning events
+extern FaultEvents faultEvents;
+
+#endif
@@ -0,0 +1,258 @@
+///////////////////////////////////////////////////////////////////////////////
+// gridCapture.cpp
+//
+// Triggered high-rate capture of grid frequency/voltage and output power
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Re-arm with hysteresis and holdoff (CAP_HOLDOFF)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "gridCapture.h"
+
+#if defined(CAPTURE_EN)
+
+GridCapture gridCapture;
+
+// Scale float value to fixed-point integer (CAPTURE_INVALID is reserved)
+static uint16_t fixp16(float value, float scale)
+{
+    int32_t v = lroundf(value * scale);
+    return (v < 0) ? 0 : (v >= CAPTURE_INVALID) ? CAPTURE_INVALID - 1 : v;
+}
+
+// Zigzag encoded difference of two field values (modulo 2^16)
+static uint16_t zigzag(uint16_t prev, uint16_t cur)
+{
+    int16_t d = (int16_t)(cur - prev);
+    return ((uint16_t)d << 1) ^ (uint16_t)(d >> 15);
+}
+
+// Size of varint
+static uint8_t varintSize(uint16_t v)
+{
+    return (v < 0x80) ? 1 : (v < 0x4000) ? 2 : 3;
+}
+
+// Write varint (7 bits per byte, LSB first)
+static void writeVarint(LoraEncoder &encoder, uint16_t v)
+{
+    while (v >= 0x80) {
+        encoder.writeUint8((v & 0x7F) | 0x80);
+        v >>= 7;
+    }
+    encoder.writeUint8(v);
+}
+
+// Size of encoded sample (differences to previous sample)
+static uint8_t deltaSize(const CaptureSample &prev, const CaptureSample &cur)
+{
+    return varintSize(zigzag(prev.frequency, cur.frequency)) +
+           varintSize(zigzag(prev.voltage, cur.voltage)) +
+           varintSize(zigzag(prev.power, cur.power));
+}
+
+bool GridCapture::isDue(void)
+{
+    if (m_state == CAP_FROZEN)
+        return false;
+
+    uint32_t now = millis();
+    if ((int32_t)(now - m_tPoll) < 0)
+        return false;
+
+    // fixed cadence; resynchronize if polls have been missed
+    m_tPoll += CAPTURE_PERIOD;
+    if ((int32_t)(now - m_tPoll) >= 0)
+        m_tPoll = now + CAPTURE_PERIOD;
+    return true;
+}
+
+// Returns true if the window has been frozen
+bool GridCapture::write(const CaptureSample &s)
+{
+    m_buf[m_head] = s;
+    m_head = (m_head + 1) % CAPTURE_SIZE;
+    if (m_count < CAPTURE_SIZE)
+        m_count++;
+
+    if ((m_state == CAP_TRIGGERED) && (--m_post == 0)) {
+        m_state   = CAP_FROZEN;
+        m_trigger = m_count - 1 - CAPTURE_POST;
+        m_sendPos = 0;
+        m_sendLen = 0;
+        return true;
+    }
+    return false;
+}
+
+const CaptureSample &GridCapture::at(uint16_t idx)
+{
+    uint16_t start = (m_head + CAPTURE_SIZE - m_count) % CAPTURE_SIZE;
+    return m_buf[(start + idx) % CAPTURE_SIZE];
+}
+
+void GridCapture::add(const modbus_input_registers &data, uint32_t time)
+{
+    static const CaptureSample invalid = {CAPTURE_INVALID, CAPTURE_INVALID, CAPTURE_INVALID};
+    bool triggered = false;
+    bool frozen    = false;
+    bool rearmed   = false;
+
+    // Samples are added by the acquisition task and sent from loop()
+    portENTER_CRITICAL(&m_mux);
+
+    // missed polls
+    if (m_valid) {
+        uint32_t slots = (time - m_tLast + CAPTURE_PERIOD / 2) / CAPTURE_PERIOD;
+        for (uint32_t i = 1; (i < slots) && (i <= CAPTURE_SIZE) && (m_state != CAP_FROZEN); i++)
+            frozen |= write(invalid);
+    }
+    if (!m_valid)
+        m_tNormal = time;
+    m_tLast = time;
+    m_valid = true;
+
+    if (m_state != CAP_FROZEN) {
+        // no trigger without grid measurement (e.g. inverter not connected yet)
+        bool    measured = (data.gridfrequency > 0) && (data.gridvoltage > 0);
+        float   freqDev  = fabsf(data.gridfrequency - CAPTURE_FREQ_NOM);
+        uint8_t cause = 0;
+        if (measured && freqDev > CAPTURE_FREQ_DEV)
+            cause |= CAPTURE_CAUSE_FREQ;
+        if (measured && ((data.gridvoltage < CAPTURE_VOLT_MIN) || (data.gridvoltage > CAPTURE_VOLT_MAX)))
+            cause |= CAPTURE_CAUSE_VOLT;
+
+        if (m_state == CAP_HOLDOFF) {
+            // values must stay inside the limits (with hysteresis) for the holdoff time
+            bool normal = measured && (freqDev <= CAPTURE_FREQ_DEV - CAPTURE_FREQ_HYST) &&
+                          (data.gridvoltage >= CAPTURE_VOLT_MIN + CAPTURE_VOLT_HYST) &&
+                          (data.gridvoltage <= CAPTURE_VOLT_MAX - CAPTURE_VOLT_HYST);
+            if (!normal) {
+                m_tNormal = time;
+            } else if (time - m_tNormal >= CAPTURE_REARM_HOLDOFF * 1000UL) {
+                m_state = CAP_ARMED;
+                rearmed = true;
+            }
+        }
+
+        if ((m_state == CAP_ARMED) && cause) {
+            // trigger sample + post-trigger window
+            m_state = CAP_TRIGGERED;
+            m_post  = CAPTURE_POST + 1;
+            m_cause = cause;
+            m_time  = ::time(nullptr);
+            triggered = true;
+        }
+
+        CaptureSample s;
+        s.frequency = fixp16(data.gridfrequency, 100);
+        s.voltage   = fixp16(data.gridvoltage, 10);
+        s.power     = fixp16(data.outputpower, 1);
+        frozen |= write(s);
+    }
+    portEXIT_CRITICAL(&m_mux);
+
+    if (rearmed)
+        log_i("Capture #%u: re-armed", m_seq);
+    if (triggered)
+        log_i("Capture #%u: triggered (cause 0x%02X)", m_seq, m_cause);
+    if (frozen)
+        log_i("Capture #%u: frozen (%u samples, trigger at %u)", m_seq, m_count, m_trigger);
+}
+
+bool GridCapture::isReady(void)
+{
+    return (m_state == CAP_FROZEN) && (m_sendPos < m_count);
+}
+
+uint8_t GridCapture::encode(LoraEncoder &encoder, uint8_t size)
+{
+    // window is not modified while frozen
+    if (!isReady() || (size < CAPTURE_HEADER))
+        return 0;
+
+    // no. of samples fitting into payload
+    uint16_t len = CAPTURE_HEADER;
+    uint16_t n   = 1;
+    while ((m_sendPos + n < m_count) && (n < UINT8_MAX)) {
+        uint8_t l = deltaSize(at(m_sendPos + n - 1), at(m_sendPos + n));
+        if (len + l > size)
+            break;
+        len += l;
+        n++;
+    }
+
+    encoder.writeUint8(m_seq);
+    encoder.writeUint8(m_cause);
+    encoder.writeUint16(m_sendPos);
+    encoder.writeUint16(m_count);
+    encoder.writeUint16(m_trigger);
+    encoder.writeUint16(CAPTURE_PERIOD);
+    encoder.writeUint32(m_time);
+    encoder.writeUint8(n);
+
+    const CaptureSample &first = at(m_sendPos);
+    encoder.writeUint16(first.frequency);
+    encoder.writeUint16(first.voltage);
+    encoder.writeUint16(first.power);
+    for (uint16_t i = 1; i < n; i++) {
+        const CaptureSample &prev = at(m_sendPos + i - 1);
+        const CaptureSample &cur  = at(m_sendPos + i);
+        writeVarint(encoder, zigzag(prev.frequency, cur.frequency));
+        writeVarint(encoder, zigzag(prev.voltage, cur.voltage));
+        writeVarint(encoder, zigzag(prev.power, cur.power));
+    }
+    m_sendLen = n;
+    return n;
+}
+
+void GridCapture::sent(void)
+{
+    m_sendPos += m_sendLen;
+    m_sendLen  = 0;
+    if (m_sendPos < m_count)
+        return;
+
+    log_i("Capture #%u: sent - holdoff", m_seq);
+    portENTER_CRITICAL(&m_mux);
+    m_seq++;
+    m_head  = 0;
+    m_count = 0;
+    m_valid = false;
+    m_state = CAP_HOLDOFF;
+    portEXIT_CRITICAL(&m_mux);
+}
+
+#endif
@@ -0,0 +1,179 @@
+///////////////////////////////////////////////////////////////////////////////
+// gridCapture.h
+//
+// Triggered high-rate capture of grid frequency/voltage and output power
+//
+// While armed, only gridfrequency, gridvoltage and outputpower of the first
+// inverter are polled every CAPTURE_PERIOD ms into a circular buffer
+// (preallocated, CAPTURE_PRE + 1 + CAPTURE_POST samples). If the frequency
+// deviates from CAPTURE_FREQ_NOM by more than CAPTURE_FREQ_DEV or the
+// voltage leaves CAPTURE_VOLT_MIN...CAPTURE_VOLT_MAX, the buffer is frozen
+// CAPTURE_POST samples later. The frozen window is sent in chunks on port
+// PAYLOAD_PORT_CAPTURE (one chunk every CAPTURE_UPLINK_INTERVAL seconds).
+// After the last chunk, the capture is re-armed only when frequency and
+// voltage have been back inside the trigger limits (narrowed by
+// CAPTURE_FREQ_HYST/CAPTURE_VOLT_HYST) for CAPTURE_REARM_HOLDOFF seconds,
+// i.e. a persistent deviation is captured only once.
+// Polls which were missed (e.g. during a regular acquisition) are stored
+// as invalid samples (all fields 0xFFFF).
+//
+// Capture payload (port PAYLOAD_PORT_CAPTURE, little endian):
+// byte 0:      capture sequence no.
+// byte 1:      trigger cause (bit 0: frequency, bit 1: voltage)
+// byte 2..3:   index of first sample in this chunk
+// byte 4..5:   no. of samples in window
+// byte 6..7:   index of trigger sample
+// byte 8..9:   sample period [ms]
+// byte 10..13: trigger time (UNIX time)
+// byte 14:     no. of samples in this chunk
+// byte 15..20: first sample - gridfrequency [0.01 Hz], gridvoltage [0.1 V],
+//              outputpower [W] (uint16 each)
+// byte 21...:  following samples - difference to previous sample per field
+//              (int16, modulo 2^16), zigzag encoded as varint (7 bits per
+//              byte, LSB first, bit 7: more bytes follow)
+//
+// Each chunk can be decoded on its own.
+// Capture requires continuous operation (not available with SLEEP_EN).
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Re-arm with hysteresis and holdoff (CAP_HOLDOFF)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef GRID_CAPTURE_H
+#define GRID_CAPTURE_H
+
+#include "Arduino.h"
+#include <LoraMessage.h>
+#include "settings.h"
+#include "growattRegisters.h"
+
+#define CAPTURE_SIZE        (CAPTURE_PRE + 1 + CAPTURE_POST) // capture window in samples (incl. trigger)
+#define CAPTURE_HEADER      21                              // size of chunk header incl. first sample
+#define CAPTURE_INVALID     0xFFFF                          // field value of missed sample
+
+#define CAPTURE_CAUSE_FREQ  0x01        // trigger cause: frequency deviation
+#define CAPTURE_CAUSE_VOLT  0x02        // trigger cause: voltage out of range
+
+/// Capture sample (fixed-point)
+struct CaptureSample {
+    uint16_t frequency;         //!< gridfrequency [0.01 Hz]
+    uint16_t voltage;           //!< gridvoltage [0.1 V]
+    uint16_t power;             //!< outputpower [W]
+};
+
+/*!
+ * \class GridCapture
+ *
+ * \brief Triggered capture buffer with pre-/post-trigger windows
+ */
+class GridCapture {
+public:
+    /// Capture state
+    enum State : uint8_t {
+        CAP_ARMED,              //!< sampling, waiting for trigger
+        CAP_TRIGGERED,          //!< sampling post-trigger window
+        CAP_FROZEN,             //!< window complete, sending
+        CAP_HOLDOFF             //!< sampling, waiting for normal values before re-arming
+    };
+
+    GridCapture() {};
+
+    /*!
+     * \brief Check if the next capture poll is due
+     *
+     * Advances the poll schedule if true is returned.
+     */
+    bool isDue(void);
+
+    /*!
+     * \brief Add sample
+     *
+     * \param data     input register data (gridfrequency, gridvoltage, outputpower)
+     * \param time     sample time [ms]
+     */
+    void add(const modbus_input_registers &data, uint32_t time);
+
+    /// Frozen window has unsent samples
+    bool isReady(void);
+
+    /*!
+     * \brief Encode next chunk of frozen window
+     *
+     * \param encoder  LoRaWAN payload encoder
+     * \param size     max. payload size
+     *
+     * \returns no. of samples encoded
+     */
+    uint8_t encode(LoraEncoder &encoder, uint8_t size);
+
+    /*!
+     * \brief Advance to next chunk after the last encode()
+     *
+     * Unconfirmed uplinks - a chunk is not repeated. After the last
+     * chunk, the capture enters CAP_HOLDOFF.
+     */
+    void sent(void);
+
+    /// Capture state
+    State state(void) {
+        return m_state;
+    }
+
+private:
+    bool write(const CaptureSample &s);
+    const CaptureSample &at(uint16_t idx);
+
+    CaptureSample m_buf[CAPTURE_SIZE];      //!< circular buffer
+    State         m_state = CAP_ARMED;      //!< capture state
+    uint16_t      m_head = 0;               //!< next write position
+    uint16_t      m_count = 0;              //!< no. of valid samples in buffer
+    uint16_t      m_post;                   //!< post-trigger samples to go
+    uint16_t      m_trigger;                //!< index of trigger sample in window
+    uint16_t      m_sendPos;                //!< index of next sample to send
+    uint16_t      m_sendLen;                //!< no. of samples in last chunk
+    uint8_t       m_seq = 0;                //!< capture sequence no.
+    uint8_t       m_cause;                  //!< trigger cause
+    uint32_t      m_time;                   //!< trigger time (UNIX time)
+    uint32_t      m_tLast;                  //!< time of last sample [ms]
+    uint32_t      m_tPoll = 0;              //!< time of next poll [ms]
+    uint32_t      m_tNormal;                //!< start of normal values in CAP_HOLDOFF [ms]
+    bool          m_valid = false;          //!< m_tLast is valid
+    portMUX_TYPE  m_mux = portMUX_INITIALIZER_UNLOCKED;
+};
+
+/// Grid capture of (first) inverter's data
+extern GridCapture gridCapture;
+
+#endif
@@ -4,57 +4,141 @@
 //
 // 20230313 matthias-bs Replaced SoftwareSerial by HardwareSerial
 // 20230408 Added different Modbus data rates for RS485 and USB
+// 20261016 Moved register map to growattRegisters.h
+//          Added read planner
+//          Added simulated inverter (SIM_MODBUS)
+//          Added native ESP32 Modbus RTU transport (MODBUS_NATIVE)
+//          Added slave ID selection (multiple inverters on one bus)
+//          Separate read plan position for holding registers
+//          Added readRegister() with Modbus result
+//          Added serialize() (JSON/CBOR), removed JSON output of Read*Registers()
+//          Templated on Modbus link (RS485/USB), pins from board profile (boards.h)
+//          Replaced initGrowatt() by begin() (called once after reset/wakeup)
+//          ModbusLinkAuto (runtime interface selection) only with MODBUS_IF_AUTO
 #ifndef GROWATTINTERFACE_H
 #define GROWATTINTERFACE_H
 
 #include "Arduino.h"
 #include <ModbusMaster.h>            // Modbus master library for ESP8266 by Doc Walker (https://github.com/4-20ma/ModbusMaster)
+#include "settings.h"
+#include "boards.h"
+#include "growattRegisters.h"
+#include "regSerializer.h"
+#if defined(SIM_MODBUS)
+  #include "growattSim.h"
+  typedef GrowattSim ModbusTransport;
+#elif defined(MODBUS_NATIVE)
+  #include "modbusRtu.h"
+  typedef ModbusRtu ModbusTransport;
+#else
+  /// ModbusMaster with slave ID selection
+  class ModbusMasterTransport : public ModbusMaster {
+    public:
+      void begin(uint8_t slave, Stream &serial) {
+        m_serial = &serial;
+        ModbusMaster::begin(slave, serial);
+      }
+      // Only sets the slave ID - the serial interface is not touched
+      void setSlave(uint8_t slave) {
+        ModbusMaster::begin(slave, *m_serial);
+      }
+    private:
+      Stream *m_serial;
+  };
+  typedef ModbusMasterTransport ModbusTransport;
+#endif
 #define SLAVE_ID                 1   // Default slave ID of Growatt
 #define MODBUS_RATE_RS485     9600   // Growatt Modbus data rate over RS485
 #define MODBUS_RATE_USB     115200   // Growatt Modbus data rate over USB 
+#define MODBUS_MAX_BLOCK        64   // Max. number of registers per request (ModbusMaster response buffer size)
+
+/// Modbus link via RS485 transceiver (Serial2)
+struct ModbusLinkRS485 {
+    static void select(void) {}
+    static constexpr bool rs485(void) { return true; }
+    static constexpr uint32_t rate(void) { return MODBUS_RATE_RS485; }
+    static HardwareSerial &port(void) { return Serial2; }
+    static void begin(void) {
+      Serial2.begin(MODBUS_RATE_RS485, SERIAL_8N1, board.max485Rx, board.max485Tx);
+    }
+};
+
+/// Modbus link via USB (Serial)
+struct ModbusLinkUSB {
+    static void select(void) {}
+    static constexpr bool rs485(void) { return false; }
+    static constexpr uint32_t rate(void) { return MODBUS_RATE_USB; }
+    static HardwareSerial &port(void) { return Serial; }
+    static void begin(void) {
+      Serial.begin(MODBUS_RATE_USB, SERIAL_8N1);
+    }
+};
 
-class growattIF {
+#if MODBUS_IF == MODBUS_IF_RS485
+  typedef ModbusLinkRS485 ModbusLink;
+#elif MODBUS_IF == MODBUS_IF_USB
+  typedef ModbusLinkUSB ModbusLink;
+#else
+  /// Modbus link selected by interface select pin at runtime (see select())
+  /// - rs485() etc. depend on a global flag; select MODBUS_IF_RS485 or
+  /// MODBUS_IF_USB if the interface is known at compile time
+  struct ModbusLinkAuto {
+      /// Read interface select pin - must be called once before any other method
+      static void select(void) {
+        pinMode(board.interfaceSel, INPUT_PULLUP);
+        m_rs485 = digitalRead(board.interfaceSel);
+      }
+      static bool rs485(void) { return m_rs485; }
+      static uint32_t rate(void) { return m_rs485 ? ModbusLinkRS485::rate() : ModbusLinkUSB::rate(); }
+      static HardwareSerial &port(void) { return m_rs485 ? ModbusLinkRS485::port() : ModbusLinkUSB::port(); }
+      static void begin(void) {
+        if (m_rs485) {
+          ModbusLinkRS485::begin();
+        } else {
+          ModbusLinkUSB::begin();
+        }
+      }
+      static bool m_rs485;
+  };
+
+  typedef ModbusLinkAuto ModbusLink;
+#endif
+
+template <class Link>
+class GrowattInterface {
 
   private:
-    ModbusMaster growattInterface;
-    //SoftwareSerial *serial;
-    HardwareSerial *serial;
-    void preTransmission();
-    void postTransmission();
-    int PinMAX485_RE_NEG;
-    int PinMAX485_DE;
-    int PinMAX485_RX;
-    int PinMAX485_TX;
+    ModbusTransport growattInterface;
+    static void preTransmission();
+    static void postTransmission();
     int setcounter = 0;
-    int overflow;
+    int holdcounter = 0;
+    uint8_t slaveId = SLAVE_ID;
+    uint16_t inputRegs[INPUT_REGS_NUM];
+    uint16_t holdingRegs[HOLDING_REGS_NUM];
+    RegSpan inputPlan[MAX_READ_SPANS];
+    RegSpan holdingPlan[MAX_READ_SPANS];
+    uint8_t inputPlanLen;
+    uint8_t holdingPlanLen;
+    uint8_t readBlock(bool holding, const RegSpan *plan, uint8_t nspans, uint16_t *regs, int &counter);
 
   public:
-    struct modbus_input_registers
-    {
-      int status;
-      float solarpower, pv1voltage, pv1current, pv1power, pv2voltage, pv2current, pv2power, outputpower, gridfrequency, gridvoltage;
-      float energytoday, energytotal, totalworktime, pv1energytoday, pv1energytotal, pv2energytoday, pv2energytotal, opfullpower;
-      float tempinverter, tempipm, tempboost;
-      int ipf, realoppercent, deratingmode, faultcode, faultbitcode, warningbitcode;
-    };
     struct modbus_input_registers modbusdata;
 
-    struct modbus_holding_registers
-    {
-      int enable, safetyfuncen, maxoutputactivepp, maxoutputreactivepp, modul;
-      float  maxpower, voltnormal, startvoltage, gridvoltlowlimit, gridvolthighlimit, gridfreqlowlimit, gridfreqhighlimit, gridvoltlowconnlimit, gridvolthighconnlimit, gridfreqlowconnlimit, gridfreqhighconnlimit;
-      char firmware[6], controlfirmware[6];
-      char serial[10];
-    };
-
     struct modbus_holding_registers modbussettings;
 
-    growattIF(int _PinMAX485_RE_NEG, int _PinMAX485_DE, int _PinMAX485_RX, int _PinMAX485_TX);
-    void initGrowatt();
+    GrowattInterface();
+    void begin();
+    static bool isRS485() { return Link::rs485(); }
+    void setSlave(uint8_t id);
+    uint8_t getSlave() { return slaveId; }
     uint8_t writeRegister(uint16_t reg, uint16_t message);
     uint16_t readRegister(uint16_t reg);
-    uint8_t ReadInputRegisters(char* json);
-    uint8_t ReadHoldingRegisters(char* json);
+    uint8_t readRegister(uint16_t reg, uint16_t &value);
+    void planInputRegisters(const size_t *fields, size_t nfields, uint16_t maxGap);
+    uint8_t ReadInputRegisters(void);
+    uint8_t ReadHoldingRegisters(void);
+    size_t serialize(bool holding, RegFormat fmt, uint8_t *buf, size_t size);
     String sendModbusError(uint8_t result);
 
     // Error codes
@@ -68,4 +152,6 @@ class growattIF {
     static const uint8_t regModulPower      = 121;
 };
 
+typedef GrowattInterface<ModbusLink> growattIF;
+
 #endif
@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////
+// growattRegisters.cpp
+//
+// Growatt Modbus register map - decoder
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Added read planner
+//          Raw 32-bit values of totals (RegDesc::raw)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "growattRegisters.h"
+
+void decodeRegisters(const RegDesc *table, size_t n, const uint16_t *regs, size_t nregs, void *data)
+{
+  uint8_t *base = static_cast<uint8_t *>(data);
+
+  for (size_t i = 0; i < n; i++) {
+    const RegDesc &d = table[i];
+
+    if (d.addr + d.width > nregs)
+      continue;
+
+    if (d.type == REG_STR) {
+      char *str = reinterpret_cast<char *>(base + d.offset);
+      for (uint8_t w = 0; w < d.width; w++) {
+        str[2 * w]     = regs[d.addr + w] >> 8;
+        str[2 * w + 1] = regs[d.addr + w] & 0xff;
+      }
+      continue;
+    }
+
+    // 32-bit values: high word first
+    uint32_t raw = regs[d.addr];
+    if (d.width == 2)
+      raw = (raw << 16) | regs[d.addr + 1];
+
+    int32_t val;
+    if (d.sign) {
+      val = (d.width == 2) ? static_cast<int32_t>(raw) : static_cast<int16_t>(raw);
+    } else {
+      val = static_cast<int32_t>(raw);
+    }
+
+    if (d.raw != REG_NO_RAW)
+      *reinterpret_cast<uint32_t *>(base + d.raw) = raw;
+
+    if (d.type == REG_FLOAT) {
+      *reinterpret_cast<float *>(base + d.offset) = val * d.scale;
+    } else {
+      *reinterpret_cast<int *>(base + d.offset) = val;
+    }
+  }
+}
+
+uint8_t planReads(const RegDesc *table, size_t n, const size_t *fields, size_t nfields,
+                  uint16_t maxGap, uint16_t maxLen, RegSpan *spans, uint8_t maxSpans)
+{
+  // Select register ranges, sorted by address (insertion sort - tables are short)
+  RegSpan ranges[MAX_REGS_DESC];
+  size_t nranges = 0;
+
+  for (size_t i = 0; (i < n) && (nranges < MAX_REGS_DESC); i++) {
+    bool selected = (fields == nullptr);
+    for (size_t j = 0; !selected && j < nfields; j++) {
+      selected = (fields[j] == table[i].offset);
+    }
+    if (!selected)
+      continue;
+
+    size_t k = nranges++;
+    while ((k > 0) && (ranges[k - 1].start > table[i].addr)) {
+      ranges[k] = ranges[k - 1];
+      k--;
+    }
+    ranges[k].start = table[i].addr;
+    ranges[k].count = table[i].width;
+  }
+
+  // Coalesce ranges into spans
+  uint8_t nspans = 0;
+  for (size_t i = 0; i < nranges; i++) {
+    uint16_t start = ranges[i].start;
+    uint16_t end   = ranges[i].start + ranges[i].count;
+
+    if (nspans > 0) {
+      RegSpan &last = spans[nspans - 1];
+      uint16_t lastEnd = last.start + last.count;
+
+      if (end <= lastEnd)
+        continue;
+
+      if ((start <= lastEnd + maxGap) && (end - last.start <= maxLen)) {
+        last.count = end - last.start;
+        continue;
+      }
+    }
+    if (nspans == maxSpans)
+      return 0;
+
+    spans[nspans].start = start;
+    spans[nspans].count = end - start;
+    nspans++;
+  }
+  return nspans;
+}
@@ -0,0 +1,309 @@
+///////////////////////////////////////////////////////////////////////////////
+// growattRegisters.h
+//
+// Growatt Modbus register map - descriptor tables and decoder
+//
+// The register map is defined once as a table of descriptors
+// (address, width, scale, signedness, target field). A single decode loop
+// converts a raw register image into the data structures.
+// This file does not depend on the Arduino framework and can be compiled
+// on the host, e.g. for checking the decoder against recorded register dumps.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created from growattInterface.cpp
+//          Fixed register mapping of deratingmode (104) and faultbitcode (106/107)
+//          Added read planner
+//          Added field names to register descriptors
+//          Raw 32-bit values of totals (exact - float has 24 bit mantissa)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef GROWATTREGISTERS_H
+#define GROWATTREGISTERS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define INPUT_REGS_NUM      128     // Size of input register image
+#define HOLDING_REGS_NUM    128     // Size of holding register image
+
+struct modbus_input_registers
+{
+  int status;
+  float solarpower, pv1voltage, pv1current, pv1power, pv2voltage, pv2current, pv2power, outputpower, gridfrequency, gridvoltage;
+  float energytoday, energytotal, totalworktime, pv1energytoday, pv1energytotal, pv2energytoday, pv2energytotal, opfullpower;
+  float tempinverter, tempipm, tempboost;
+  int ipf, realoppercent, deratingmode, faultcode, faultbitcode, warningbitcode;
+  // raw register values of totals (exact; float values are rounded above 2^24 counts)
+  uint32_t energytotal_raw, totalworktime_raw, pv1energytotal_raw;
+};
+
+struct modbus_holding_registers
+{
+  int enable, safetyfuncen, maxoutputactivepp, maxoutputreactivepp, modul;
+  float  maxpower, voltnormal, startvoltage, gridvoltlowlimit, gridvolthighlimit, gridfreqlowlimit, gridfreqhighlimit, gridvoltlowconnlimit, gridvolthighconnlimit, gridfreqlowconnlimit, gridfreqhighconnlimit;
+  char firmware[6], controlfirmware[6];
+  char serial[10];
+};
+
+// Target field type
+enum RegType : uint8_t {
+  REG_INT,                // int
+  REG_FLOAT,              // float, raw value * scale
+  REG_STR                 // char[2 * width], high byte first
+};
+
+// Register descriptor
+struct RegDesc {
+  uint16_t addr;          // register address (high word of 32-bit values)
+  uint8_t  width;         // number of 16-bit registers
+  RegType  type;          // target field type
+  bool     sign;          // raw value is signed
+  float    scale;         // scale factor (REG_FLOAT only)
+  size_t   offset;        // offset of target field in data structure
+  const char *name;       // field name (e.g. JSON key)
+  size_t   raw;           // offset of uint32_t copy of raw value (REG_NO_RAW: none)
+};
+
+#define REG_NO_RAW  SIZE_MAX
+
+#define REG_I(s, f, a, w, sg)       { a, w, REG_INT,   sg,    1.0f, offsetof(s, f), #f, REG_NO_RAW }
+#define REG_F(s, f, a, w, sg, sc)   { a, w, REG_FLOAT, sg,    sc,   offsetof(s, f), #f, REG_NO_RAW }
+#define REG_S(s, f, a, w)           { a, w, REG_STR,   false, 1.0f, offsetof(s, f), #f, REG_NO_RAW }
+// float value and raw value (field f ## _raw)
+#define REG_FR(s, f, a, w, sg, sc)  { a, w, REG_FLOAT, sg,    sc,   offsetof(s, f), #f, offsetof(s, f ## _raw) }
+
+// Input registers (function code 0x04)
+static constexpr RegDesc inputRegisterMap[] = {
+  // Status and PV data
+  REG_I(modbus_input_registers, status,           0, 1, false),
+  REG_F(modbus_input_registers, solarpower,       1, 2, false, 0.1f),
+  REG_F(modbus_input_registers, pv1voltage,       3, 1, false, 0.1f),
+  REG_F(modbus_input_registers, pv1current,       4, 1, false, 0.1f),
+  REG_F(modbus_input_registers, pv1power,         5, 2, false, 0.1f),
+  REG_F(modbus_input_registers, pv2voltage,       7, 1, false, 0.1f),
+  REG_F(modbus_input_registers, pv2current,       8, 1, false, 0.1f),
+  REG_F(modbus_input_registers, pv2power,         9, 2, false, 0.1f),
+
+  // Output
+  REG_F(modbus_input_registers, outputpower,     35, 2, false, 0.1f),
+  REG_F(modbus_input_registers, gridfrequency,   37, 1, false, 0.01f),
+  REG_F(modbus_input_registers, gridvoltage,     38, 1, false, 0.1f),
+
+  // Energy
+  REG_F(modbus_input_registers, energytoday,     53, 2, false, 0.1f),
+  REG_FR(modbus_input_registers, energytotal,    55, 2, false, 0.1f),
+  REG_FR(modbus_input_registers, totalworktime,  57, 2, false, 0.5f),
+  REG_F(modbus_input_registers, pv1energytoday,  59, 2, false, 0.1f),
+  REG_FR(modbus_input_registers, pv1energytotal, 61, 2, false, 0.1f),
+  REG_F(modbus_input_registers, pv2energytoday,  63, 2, false, 0.1f),
+  REG_F(modbus_input_registers, pv2energytotal,  65, 2, false, 0.1f),
+
+  // Temperatures
+  REG_F(modbus_input_registers, tempinverter,    93, 1, true,  0.1f),
+  REG_F(modbus_input_registers, tempipm,         94, 1, true,  0.1f),
+  REG_F(modbus_input_registers, tempboost,       95, 1, true,  0.1f),
+
+  // Diag data
+  REG_I(modbus_input_registers, ipf,            100, 1, false),
+  REG_I(modbus_input_registers, realoppercent,  101, 1, false),
+  REG_F(modbus_input_registers, opfullpower,    102, 2, false, 0.1f),
+
+  //  0:no derate;
+  //  1:PV;
+  //  2:*;
+  //  3:Vac;
+  //  4:Fac;
+  //  5:Tboost;
+  //  6:Tinv;
+  //  7:Control;
+  //  8:*;
+  //  9:*OverBack
+  //  ByTime;
+  REG_I(modbus_input_registers, deratingmode,   104, 1, false),
+
+  //  1~23 " Error: 99+x
+  //  24 "Auto Test
+  //  25 "No AC
+  //  26 "PV Isolation Low",
+  //  27 " Residual I
+  //  28 " Output High
+  //  29 " PV Voltage
+  //  30 " AC V Outrange
+  //  31 " AC F Outrange
+  //  32 " Module Hot
+  REG_I(modbus_input_registers, faultcode,      105, 1, false),
+
+  //  0x00000001 %
+  //  0x00000002 Communication error
+  //  0x00000004 %
+  //  0x00000008 StrReverse or StrShort fault
+  //  0x00000010 Model Init fault
+  //  0x00000020 Grid Volt Sample diffirent
+  //  0x00000040 ISO Sample diffirent
+  //  0x00000080 GFCI Sample diffirent
+  //  0x00000100 %
+  //  0x00000200 %
+  //  0x00000400 %
+  //  0x00000800 %
+  //  0x00001000 AFCI Fault
+  //  0x00002000 %
+  //  0x00004000 AFCI Module fault
+  //  0x00008000 %
+  //  0x00010000 %
+  //  0x00020000 Relay check fault
+  //  0x00040000 %
+  //  0x00080000 %
+  //  0x00100000 %
+  //  0x00200000 Communication error
+  //  0x00400000 Bus Voltage error
+  //  0x00800000 AutoTest fail
+  //  0x01000000 No Utility
+  //  0x02000000 PV Isolation Low
+  //  0x04000000 Residual I High
+  //  0x08000000 Output High DCI
+  //  0x10000000 PV Voltage high
+  //  0x20000000 AC V Outrange
+  //  0x40000000 AC F Outrange
+  //  0x80000000 TempratureHigh
+  REG_I(modbus_input_registers, faultbitcode,   106, 2, false),
+
+  //  0x0001 Fan warning
+  //  0x0002 String communication abnormal
+  //  0x0004 StrPIDconfig Warning
+  //  0x0008 %
+  //  0x0010 DSP and COM firmware unmatch
+  //  0x0020 %
+  //  0x0040 SPD abnormal
+  //  0x0080 GND and N connect abnormal
+  //  0x0100 PV1 or PV2 circuit short
+  //  0x0200 PV1 or PV2 boost driver broken
+  //  0x0400 %
+  //  0x0800 %
+  //  0x1000 %
+  //  0x2000 %
+  //  0x4000 %
+  //  0x8000 %
+  REG_I(modbus_input_registers, warningbitcode, 110, 2, false)
+};
+
+// Holding registers (function code 0x03)
+static constexpr RegDesc holdingRegisterMap[] = {
+  REG_I(modbus_holding_registers, enable,                  0, 1, false),
+
+  //  Bit0: SPI enable
+  //  Bit1: AutoTestStart
+  //  Bit2: LVFRT enable
+  //  Bit3: FreqDerating Enable
+  //  Bit4: Softstart enable
+  //  Bit5: DRMS enable
+  //  Bit6: Power Volt Func Enable
+  //  Bit7: HVFRT enable
+  //  Bit8: ROCOF enable
+  //  Bit9: Recover FreqDerating Mode Enable
+  //  Bit10~15: Reserved
+  REG_I(modbus_holding_registers, safetyfuncen,            1, 1, false),
+
+  // Inverter max output active/reactive power percent  0-100: %, 255: not limited
+  REG_I(modbus_holding_registers, maxoutputactivepp,       3, 1, false),
+  REG_I(modbus_holding_registers, maxoutputreactivepp,     4, 1, false),
+  REG_F(modbus_holding_registers, maxpower,                6, 2, false, 0.1f),
+  REG_F(modbus_holding_registers, voltnormal,              8, 1, false, 0.1f),
+  REG_S(modbus_holding_registers, firmware,                9, 3),
+  REG_S(modbus_holding_registers, controlfirmware,        12, 3),
+  REG_F(modbus_holding_registers, startvoltage,           17, 1, false, 0.1f),
+  REG_S(modbus_holding_registers, serial,                 23, 5),
+  REG_F(modbus_holding_registers, gridvoltlowlimit,       52, 1, false, 0.1f),
+  REG_F(modbus_holding_registers, gridvolthighlimit,      53, 1, false, 0.1f),
+  REG_F(modbus_holding_registers, gridfreqlowlimit,       54, 1, false, 0.01f),
+  REG_F(modbus_holding_registers, gridfreqhighlimit,      55, 1, false, 0.01f),
+  REG_F(modbus_holding_registers, gridvoltlowconnlimit,   64, 1, false, 0.1f),
+  REG_F(modbus_holding_registers, gridvolthighconnlimit,  65, 1, false, 0.1f),
+  REG_F(modbus_holding_registers, gridfreqlowconnlimit,   66, 1, false, 0.01f),
+  REG_F(modbus_holding_registers, gridfreqhighconnlimit,  67, 1, false, 0.01f),
+  REG_I(modbus_holding_registers, modul,                 121, 1, false)
+};
+
+#define NUM_INPUT_REGS_DESC     (sizeof(inputRegisterMap) / sizeof(RegDesc))
+#define NUM_HOLDING_REGS_DESC   (sizeof(holdingRegisterMap) / sizeof(RegDesc))
+
+#define MAX_REGS_DESC          48   // Max. number of entries per descriptor table
+#define MAX_READ_SPANS          8   // Max. number of Modbus read transactions per plan
+
+static_assert(NUM_INPUT_REGS_DESC <= MAX_REGS_DESC, "inputRegisterMap too large");
+static_assert(NUM_HOLDING_REGS_DESC <= MAX_REGS_DESC, "holdingRegisterMap too large");
+
+// Field selector - offset of field in data structure
+#define INPUT_FIELD(f)          offsetof(modbus_input_registers, f)
+#define HOLDING_FIELD(f)        offsetof(modbus_holding_registers, f)
+
+// Contiguous register range read by a single Modbus transaction
+struct RegSpan {
+  uint16_t start;         // first register address
+  uint16_t count;         // number of registers
+};
+
+/*!
+ * \brief Decode raw register image into data structure
+ *
+ * \param table     descriptor table
+ * \param n         number of entries
+ * \param regs      raw register image, indexed by register address
+ * \param nregs     size of raw register image
+ * \param data      target data structure (matching the table)
+ */
+void decodeRegisters(const RegDesc *table, size_t n, const uint16_t *regs, size_t nregs, void *data);
+
+/*!
+ * \brief Plan Modbus read transactions for a set of fields
+ *
+ * The register ranges of the selected fields are sorted and coalesced into
+ * the smallest number of spans. Two ranges are merged if the gap between them
+ * does not exceed maxGap registers and the resulting span does not exceed
+ * maxLen registers.
+ *
+ * \param table     descriptor table
+ * \param n         number of entries
+ * \param fields    field offsets (see INPUT_FIELD()/HOLDING_FIELD()); NULL selects all fields
+ * \param nfields   number of field offsets
+ * \param maxGap    max. number of unused registers within a span
+ * \param maxLen    max. number of registers per span
+ * \param spans     resulting spans
+ * \param maxSpans  max. number of spans
+ *
+ * \returns number of spans, 0 if maxSpans was exceeded
+ */
+uint8_t planReads(const RegDesc *table, size_t n, const size_t *fields, size_t nfields,
+                  uint16_t maxGap, uint16_t maxLen, RegSpan *spans, uint8_t maxSpans);
+
+#endif
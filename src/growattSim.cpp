@@ -0,0 +1,166 @@
+///////////////////////////////////////////////////////////////////////////////
+// growattSim.cpp
+//
+// Simulated Growatt inverter (Modbus slave)
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Fixed unit of simulated energy (totals increased 100x too fast)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "growattSim.h"
+
+#define ENERGY_UNIT 3600000000ULL   // 0.1 kWh in units of m_energy [0.1 W * ms]
+
+// Write 32-bit value to register pair (high word first)
+static void put32(uint16_t *regs, uint16_t addr, uint32_t value)
+{
+    regs[addr]     = value >> 16;
+    regs[addr + 1] = value & 0xFFFF;
+}
+
+void GrowattSim::begin(uint8_t slave, Stream &serial)
+{
+    m_slave = slave;
+    if (m_init)
+        return;
+
+    memset(m_input, 0, sizeof(m_input));
+    memset(m_holding, 0, sizeof(m_holding));
+
+    // Holding registers
+    m_holding[0]  = 1;                  // enable
+    m_holding[3]  = 100;                // maxoutputactivepp
+    m_holding[4]  = 255;                // maxoutputreactivepp
+    put32(m_holding, 6, 6000);          // maxpower [0.1 W]
+    m_holding[8]  = 2300;               // voltnormal [0.1 V]
+    m_holding[9]  = ('S' << 8) | 'I';   // firmware
+    m_holding[10] = ('M' << 8) | '1';
+    m_holding[11] = ('.' << 8) | '0';
+    m_holding[17] = 800;                // startvoltage [0.1 V]
+    m_holding[52] = 1840;               // gridvoltlowlimit [0.1 V]
+    m_holding[53] = 2640;               // gridvolthighlimit [0.1 V]
+    m_holding[54] = 4750;               // gridfreqlowlimit [0.01 Hz]
+    m_holding[55] = 5150;               // gridfreqhighlimit [0.01 Hz]
+    m_holding[121] = 0x0600;            // modul
+
+    m_energy  = 4444ULL * ENERGY_UNIT;  // 444.4 kWh
+    m_tUpdate = millis();
+    m_init    = true;
+    update();
+}
+
+// Update simulated input registers from elapsed time
+void GrowattSim::update(void)
+{
+    uint32_t tNow = millis();
+    uint32_t dt   = tNow - m_tUpdate;
+    m_tUpdate     = tNow;
+
+    // PV power varies slowly between 0 and 500 W (period 1 h)
+    float    phase  = (tNow % 3600000UL) * (2 * M_PI / 3600000.0);
+    uint32_t power  = 2500 + 2500 * sinf(phase);    // [0.1 W]
+    uint16_t pvVolt = 300 + random(50);             // [0.1 V]
+
+    m_energy += (uint64_t)power * dt;               // [0.1 W * ms]
+
+    m_input[0] = (power > 0) ? 1 : 0;               // status
+    put32(m_input, 1, power);                       // solarpower
+    m_input[3] = pvVolt;                            // pv1voltage
+    m_input[4] = (power * 10) / pvVolt;             // pv1current [0.1 A]
+    put32(m_input, 5, power);                       // pv1power
+    put32(m_input, 35, power * 95 / 100);           // outputpower
+    m_input[37] = 4995 + random(10);                // gridfrequency [0.01 Hz]
+    m_input[38] = 2280 + random(40);                // gridvoltage [0.1 V]
+    put32(m_input, 55, m_energy / ENERGY_UNIT);     // energytotal [0.1 kWh]
+    put32(m_input, 57, 2 * (tNow / 1000));          // totalworktime [0.5 s]
+    put32(m_input, 61, m_energy / ENERGY_UNIT);     // pv1energytotal [0.1 kWh]
+    m_input[93] = 250 + random(20);                 // tempinverter [0.1 °C]
+    m_input[94] = 300 + random(20);                 // tempipm [0.1 °C]
+}
+
+// Simulate Modbus transaction timing and errors
+uint8_t GrowattSim::transaction(uint16_t addr, uint16_t count, uint16_t size, const uint16_t *regs)
+{
+    if (!m_init)
+        return ku8MBInvalidSlaveID;
+
+    if (m_offline || (m_slave == 0) || (m_slave > SIM_MODBUS_SLAVES) ||
+        ((uint16_t)random(1000) < m_timeoutErr)) {
+        delay(SIM_MODBUS_TIMEOUT);
+        return ku8MBResponseTimedOut;
+    }
+
+    // request (8 bytes) + response (5 bytes + 2 bytes per register), 11 bits per byte
+    uint32_t bits = (8 + 5 + 2 * count) * 11;
+    delay(m_latency + (bits * 1000) / m_baud);
+
+    if ((uint16_t)random(1000) < m_crcErr)
+        return ku8MBInvalidCRC;
+
+    if ((count == 0) || (count > 64) || (addr + count > size))
+        return ku8MBIllegalDataAddress;
+
+    if (regs) {
+        memcpy(m_response, &regs[addr], count * sizeof(uint16_t));
+    }
+    return ku8MBSuccess;
+}
+
+uint8_t GrowattSim::readInputRegisters(uint16_t addr, uint16_t count)
+{
+    update();
+    return transaction(addr, count, INPUT_REGS_NUM, m_input);
+}
+
+uint8_t GrowattSim::readHoldingRegisters(uint16_t addr, uint16_t count)
+{
+    return transaction(addr, count, HOLDING_REGS_NUM, m_holding);
+}
+
+uint8_t GrowattSim::writeSingleRegister(uint16_t addr, uint16_t value)
+{
+    uint8_t result = transaction(addr, 1, HOLDING_REGS_NUM, nullptr);
+
+    if (result == ku8MBSuccess) {
+        m_holding[addr] = value;
+        m_response[0]   = value;
+    }
+    return result;
+}
+
+uint16_t GrowattSim::getResponseBuffer(uint8_t index)
+{
+    return (index < 64) ? m_response[index] : 0xFFFF;
+}
@@ -0,0 +1,150 @@
+///////////////////////////////////////////////////////////////////////////////
+// growattSim.h
+//
+// Simulated Growatt inverter (Modbus slave)
+//
+// Drop-in replacement for ModbusMaster (as far as used by growattIF) which
+// answers requests from simulated register images instead of accessing the
+// serial interface. Response latency, transfer time at the configured data
+// rate, CRC errors, timeouts and an offline inverter can be injected,
+// either at compile time (settings.h) or at run time.
+//
+// This allows to exercise and measure the acquisition and encoding paths
+// without an inverter being connected.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Fixed unit of simulated energy
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef GROWATTSIM_H
+#define GROWATTSIM_H
+
+#include "Arduino.h"
+#include "growattRegisters.h"
+
+#ifndef SIM_MODBUS_LATENCY
+    #define SIM_MODBUS_LATENCY      20      // response latency in ms
+#endif
+#ifndef SIM_MODBUS_CRC_ERR
+    #define SIM_MODBUS_CRC_ERR      0       // CRC error rate in per mille
+#endif
+#ifndef SIM_MODBUS_TIMEOUT_ERR
+    #define SIM_MODBUS_TIMEOUT_ERR  0       // timeout rate in per mille
+#endif
+#ifndef SIM_MODBUS_SLAVES
+    #define SIM_MODBUS_SLAVES       1       // no. of simulated inverters
+#endif
+#define SIM_MODBUS_TIMEOUT          2000    // response timeout in ms (as ModbusMaster)
+
+/*!
+ * \class GrowattSim
+ *
+ * \brief Simulated Growatt inverter with ModbusMaster compatible interface
+ */
+class GrowattSim {
+public:
+    // Modbus exception codes / ModbusMaster error codes
+    static const uint8_t ku8MBIllegalFunction       = 0x01;
+    static const uint8_t ku8MBIllegalDataAddress    = 0x02;
+    static const uint8_t ku8MBIllegalDataValue      = 0x03;
+    static const uint8_t ku8MBSlaveDeviceFailure    = 0x04;
+    static const uint8_t ku8MBSuccess               = 0x00;
+    static const uint8_t ku8MBInvalidSlaveID        = 0xE0;
+    static const uint8_t ku8MBInvalidFunction       = 0xE1;
+    static const uint8_t ku8MBResponseTimedOut      = 0xE2;
+    static const uint8_t ku8MBInvalidCRC            = 0xE3;
+
+    GrowattSim() {};
+
+    void begin(uint8_t slave, Stream &serial);
+    void preTransmission(void (*)()) {};
+
+    /// Select slave (only IDs 1...SIM_MODBUS_SLAVES respond)
+    void setSlave(uint8_t slave) {
+        m_slave = slave;
+    }
+    void postTransmission(void (*)()) {};
+
+    uint8_t readInputRegisters(uint16_t addr, uint16_t count);
+    uint8_t readHoldingRegisters(uint16_t addr, uint16_t count);
+    uint8_t writeSingleRegister(uint16_t addr, uint16_t value);
+    uint16_t getResponseBuffer(uint8_t index);
+
+    /*!
+     * \brief Set timing parameters
+     *
+     * \param baud     simulated data rate (for transfer time)
+     * \param latency  response latency in ms
+     */
+    void setTiming(uint32_t baud, uint16_t latency) {
+        m_baud    = baud;
+        m_latency = latency;
+    }
+
+    /*!
+     * \brief Set error injection rates
+     *
+     * \param crcErr       CRC error rate in per mille
+     * \param timeoutErr   timeout rate in per mille
+     */
+    void setErrorRates(uint16_t crcErr, uint16_t timeoutErr) {
+        m_crcErr     = crcErr;
+        m_timeoutErr = timeoutErr;
+    }
+
+    /// Simulate inverter without power (all requests time out)
+    void setOffline(bool offline) {
+        m_offline = offline;
+    }
+
+private:
+    uint8_t transaction(uint16_t addr, uint16_t count, uint16_t size, const uint16_t *regs);
+    void update(void);
+
+    uint16_t m_input[INPUT_REGS_NUM];       //!< simulated input registers
+    uint16_t m_holding[HOLDING_REGS_NUM];   //!< simulated holding registers
+    uint16_t m_response[64];                //!< response buffer
+    uint32_t m_baud       = 9600;
+    uint16_t m_latency    = SIM_MODBUS_LATENCY;
+    uint16_t m_crcErr     = SIM_MODBUS_CRC_ERR;
+    uint16_t m_timeoutErr = SIM_MODBUS_TIMEOUT_ERR;
+    bool     m_offline    = false;
+    uint8_t  m_slave      = 1;
+    bool     m_init       = false;
+    uint32_t m_tUpdate;                     //!< time of last update [ms]
+    uint64_t m_energy;                      //!< energy total [0.1 W * ms]
+};
+
+#endif
@@ -0,0 +1,175 @@
+///////////////////////////////////////////////////////////////////////////////
+// modbusRtu.cpp
+//
+// Native ESP32 Modbus RTU master transport
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Byte count of read responses is checked against the request
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "modbusRtu.h"
+
+static const uint8_t ku8MBReadHoldingRegisters = 0x03;
+static const uint8_t ku8MBReadInputRegisters   = 0x04;
+static const uint8_t ku8MBWriteSingleRegister  = 0x06;
+
+// Modbus CRC-16 (polynomial 0xA001, init 0xFFFF)
+static uint16_t crc16(const uint8_t *buf, size_t len)
+{
+    uint16_t crc = 0xFFFF;
+
+    for (size_t i = 0; i < len; i++) {
+        crc ^= buf[i];
+        for (int j = 0; j < 8; j++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xA001 : (crc >> 1);
+        }
+    }
+    return crc;
+}
+
+void ModbusRtu::begin(uint8_t slave, HardwareSerial &serial)
+{
+    m_slave  = slave;
+    m_serial = &serial;
+
+    if (m_rxDone == nullptr) {
+        m_rxDone = xSemaphoreCreateBinary();
+    }
+
+    if (m_dePin >= 0) {
+        // DE is driven by RTS during transmission
+        m_serial->setPins(-1, -1, -1, m_dePin);
+        m_serial->setMode(UART_MODE_RS485_HALF_DUPLEX);
+    }
+    m_serial->setRxTimeout(m_gap);
+    m_serial->onReceive([this]() {
+        xSemaphoreGive(m_rxDone);
+    }, true);
+}
+
+// Send request and receive response
+// (value: no. of registers to read or value to write)
+uint8_t ModbusRtu::transaction(uint8_t function, uint16_t addr, uint16_t value)
+{
+    uint8_t  buf[5 + 2 * MODBUS_RTU_MAX_REGS];
+    uint16_t crc;
+
+    if (m_serial == nullptr)
+        return ku8MBInvalidSlaveID;
+
+    buf[0] = m_slave;
+    buf[1] = function;
+    buf[2] = addr >> 8;
+    buf[3] = addr & 0xFF;
+    buf[4] = value >> 8;
+    buf[5] = value & 0xFF;
+    crc = crc16(buf, 6);
+    buf[6] = crc & 0xFF;
+    buf[7] = crc >> 8;
+
+    // Discard stale data
+    while (m_serial->available())
+        m_serial->read();
+    xSemaphoreTake(m_rxDone, 0);
+
+    m_serial->write(buf, 8);
+
+    // Block until the inter-frame gap has been detected
+    if (xSemaphoreTake(m_rxDone, pdMS_TO_TICKS(MODBUS_RTU_TIMEOUT)) != pdTRUE)
+        return ku8MBResponseTimedOut;
+
+    size_t len = m_serial->read(buf, sizeof(buf));
+
+    if (len < 5)
+        return ku8MBResponseTimedOut;
+
+    if (buf[0] != m_slave)
+        return ku8MBInvalidSlaveID;
+
+    if ((buf[1] & 0x7F) != function)
+        return ku8MBInvalidFunction;
+
+    // Expected frame length (exception response: 5 bytes)
+    size_t expected = (buf[1] & 0x80) ? 5 :
+                      (function == ku8MBWriteSingleRegister) ? 8 : 5 + buf[2];
+
+    if (len < expected)
+        return ku8MBResponseTimedOut;
+
+    crc = crc16(buf, expected - 2);
+    if ((buf[expected - 2] != (crc & 0xFF)) || (buf[expected - 1] != (crc >> 8)))
+        return ku8MBInvalidCRC;
+
+    if (buf[1] & 0x80)
+        return buf[2];
+
+    // read response must contain exactly the requested registers - a short
+    // response would leave stale data of a previous transaction in m_response[]
+    if ((function != ku8MBWriteSingleRegister) && (buf[2] != 2 * value))
+        return ku8MBInvalidFunction;
+
+    if (function == ku8MBWriteSingleRegister) {
+        m_response[0] = (buf[4] << 8) | buf[5];
+    } else {
+        for (uint8_t i = 0; (i < buf[2] / 2) && (i < MODBUS_RTU_MAX_REGS); i++) {
+            m_response[i] = (buf[3 + 2 * i] << 8) | buf[4 + 2 * i];
+        }
+    }
+    return ku8MBSuccess;
+}
+
+uint8_t ModbusRtu::readInputRegisters(uint16_t addr, uint16_t count)
+{
+    if ((count == 0) || (count > MODBUS_RTU_MAX_REGS))
+        return ku8MBIllegalDataValue;
+    return transaction(ku8MBReadInputRegisters, addr, count);
+}
+
+uint8_t ModbusRtu::readHoldingRegisters(uint16_t addr, uint16_t count)
+{
+    if ((count == 0) || (count > MODBUS_RTU_MAX_REGS))
+        return ku8MBIllegalDataValue;
+    return transaction(ku8MBReadHoldingRegisters, addr, count);
+}
+
+uint8_t ModbusRtu::writeSingleRegister(uint16_t addr, uint16_t value)
+{
+    return transaction(ku8MBWriteSingleRegister, addr, value);
+}
+
+uint16_t ModbusRtu::getResponseBuffer(uint8_t index)
+{
+    return (index < MODBUS_RTU_MAX_REGS) ? m_response[index] : 0xFFFF;
+}
@@ -0,0 +1,126 @@
+///////////////////////////////////////////////////////////////////////////////
+// modbusRtu.h
+//
+// Native ESP32 Modbus RTU master transport
+//
+// Drop-in replacement for ModbusMaster (as far as used by growattIF):
+// - The RS485 transceiver's DE input is driven by the UART's RTS signal in
+//   hardware RS485 half-duplex mode (no digitalWrite() in pre-/postTransmission);
+//   RE_NEG is kept low (receiver always enabled, the UART ignores the echo)
+// - The end of a response frame is detected by the UART's RX timeout
+//   (inter-frame gap) instead of polling Serial.read() until a timeout
+// - The calling task blocks on a semaphore during the transfer, so the CPU
+//   is idle (and may enter light sleep) while waiting for the response
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef MODBUSRTU_H
+#define MODBUSRTU_H
+
+#include "Arduino.h"
+
+#define MODBUS_RTU_TIMEOUT      2000    // response timeout in ms (as ModbusMaster)
+#define MODBUS_RTU_GAP_RS485    4       // inter-frame gap in characters (3.5 rounded up)
+#define MODBUS_RTU_GAP_USB      32      // inter-frame gap in characters (USB serial converter latency)
+#define MODBUS_RTU_MAX_REGS     64      // max. no. of registers per response
+
+/*!
+ * \class ModbusRtu
+ *
+ * \brief Modbus RTU master using ESP32 UART RS485 half-duplex mode and RX timeout
+ */
+class ModbusRtu {
+public:
+    // Modbus exception codes / ModbusMaster error codes
+    static const uint8_t ku8MBIllegalFunction       = 0x01;
+    static const uint8_t ku8MBIllegalDataAddress    = 0x02;
+    static const uint8_t ku8MBIllegalDataValue      = 0x03;
+    static const uint8_t ku8MBSlaveDeviceFailure    = 0x04;
+    static const uint8_t ku8MBSuccess               = 0x00;
+    static const uint8_t ku8MBInvalidSlaveID        = 0xE0;
+    static const uint8_t ku8MBInvalidFunction       = 0xE1;
+    static const uint8_t ku8MBResponseTimedOut      = 0xE2;
+    static const uint8_t ku8MBInvalidCRC            = 0xE3;
+
+    ModbusRtu() {};
+
+    /*!
+     * \brief Set RS485 DE pin
+     *
+     * Must be called before begin(); if not set (-1), the UART is used in
+     * normal mode (e.g. Modbus via USB serial converter).
+     *
+     * \param dePin    GPIO connected to the transceiver's DE input
+     */
+    void setRS485(int dePin) {
+        m_dePin = dePin;
+    }
+
+    /*!
+     * \brief Set inter-frame gap
+     *
+     * \param chars    no. of character times without data which terminate a frame
+     */
+    void setFrameGap(uint8_t chars) {
+        m_gap = chars;
+    }
+
+    void begin(uint8_t slave, HardwareSerial &serial);
+    void preTransmission(void (*)()) {};
+
+    /// Select slave for subsequent requests
+    void setSlave(uint8_t slave) {
+        m_slave = slave;
+    }
+    void postTransmission(void (*)()) {};
+
+    uint8_t readInputRegisters(uint16_t addr, uint16_t count);
+    uint8_t readHoldingRegisters(uint16_t addr, uint16_t count);
+    uint8_t writeSingleRegister(uint16_t addr, uint16_t value);
+    uint16_t getResponseBuffer(uint8_t index);
+
+private:
+    uint8_t transaction(uint8_t function, uint16_t addr, uint16_t value);
+
+    HardwareSerial    *m_serial = nullptr;      //!< UART
+    SemaphoreHandle_t  m_rxDone = nullptr;      //!< given when a frame has been received
+    uint8_t            m_slave;                 //!< slave ID
+    int                m_dePin  = -1;           //!< RS485 DE pin (RTS)
+    uint8_t            m_gap    = MODBUS_RTU_GAP_RS485;
+    uint16_t           m_response[MODBUS_RTU_MAX_REGS];  //!< response buffer
+};
+
+#endif
@@ -0,0 +1,132 @@
+///////////////////////////////////////////////////////////////////////////////
+// modbusSession.cpp
+//
+// Persistent Modbus link session
+//
+// The Modbus interface is initialized once after reset/wakeup (on the first
+// acquisition) and only re-initialized after the link has failed repeatedly.
+// The health of each inverter is tracked: failed requests are retried with
+// exponentially increasing delays, and an inverter which did not respond
+// is skipped with exponential backoff (e.g. at night), followed by a single
+// probe request.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "modbusSession.h"
+#include "acquisition.h"
+#include "payload.h"
+#include "timing.h"
+
+ModbusSession modbusSession;
+
+// No response / invalid response - a Modbus exception response means
+// that the inverter is alive
+static bool linkError(uint8_t result)
+{
+    return result >= ModbusTransport::ku8MBInvalidSlaveID;
+}
+
+uint32_t ModbusSession::open(void)
+{
+    if (!m_open) {
+        TIMING_BEGIN(tInit);
+        growattInterface.begin();
+        TIMING_END(TIMING_INIT, tInit);
+        m_open  = true;
+        m_tOpen = millis();
+        log_d("Modbus interface initialized");
+    }
+    return settleTime();
+}
+
+uint32_t ModbusSession::settleTime(void)
+{
+    uint32_t elapsed = millis() - m_tOpen;
+    return (elapsed < MODBUS_SETTLE_TIME) ? MODBUS_SETTLE_TIME - elapsed : 0;
+}
+
+bool ModbusSession::isBackoff(uint8_t idx)
+{
+    const Slave &s = m_slave[idx];
+
+    return (s.health == HEALTH_FAILED) && (millis() - s.tFail < s.backoff);
+}
+
+uint8_t ModbusSession::attempts(uint8_t idx)
+{
+    return (m_slave[idx].health == HEALTH_FAILED) ? 1 : MODBUS_RETRIES;
+}
+
+uint32_t ModbusSession::retryDelay(uint8_t retry)
+{
+    uint32_t ms = MODBUS_RETRY_DELAY;
+
+    while (retry-- && ms < MODBUS_RETRY_DELAY_MAX)
+        ms <<= 1;
+    return (ms < MODBUS_RETRY_DELAY_MAX) ? ms : MODBUS_RETRY_DELAY_MAX;
+}
+
+void ModbusSession::result(uint8_t idx, uint8_t result)
+{
+    Slave &s = m_slave[idx];
+
+    if (!linkError(result)) {
+        if (s.health == HEALTH_FAILED)
+            log_i("Slave %u - alive", modbusSlaves[idx]);
+        s.health   = HEALTH_ALIVE;
+        s.fails    = 0;
+        m_failures = 0;
+        return;
+    }
+
+    // exponential backoff
+    if (s.fails < 16)
+        s.fails++;
+    s.health  = HEALTH_FAILED;
+    s.error   = result;
+    s.tFail   = millis();
+    s.backoff = MODBUS_BACKOFF_MIN * 1000UL << (s.fails - 1);
+    if (s.backoff > MODBUS_BACKOFF_MAX * 1000UL)
+        s.backoff = MODBUS_BACKOFF_MAX * 1000UL;
+    log_i("Slave %u - no response, backoff %lu s", modbusSlaves[idx], (unsigned long)(s.backoff / 1000));
+
+    // no inverter responding - re-initialize interface with next acquisition
+    if (++m_failures >= MODBUS_REINIT_AFTER) {
+        log_w("Modbus link failed - re-initializing interface");
+        m_failures = 0;
+        m_open     = false;
+    }
+}
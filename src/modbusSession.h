@@ -0,0 +1,155 @@
+///////////////////////////////////////////////////////////////////////////////
+// modbusSession.h
+//
+// Persistent Modbus link session
+//
+// The Modbus interface is initialized once after reset/wakeup (on the first
+// acquisition) and only re-initialized after the link has failed repeatedly.
+// The health of each inverter is tracked: failed requests are retried with
+// exponentially increasing delays, and an inverter which did not respond
+// is skipped with exponential backoff (e.g. at night), followed by a single
+// probe request.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef MODBUS_SESSION_H
+#define MODBUS_SESSION_H
+
+#include "Arduino.h"
+#include "settings.h"
+
+#define MODBUS_SETTLE_TIME      500     // delay after interface initialization in ms
+#define MODBUS_RETRY_DELAY      100     // delay before first retry of a failed request in ms
+#define MODBUS_RETRY_DELAY_MAX  1000    // max. delay before retrying a failed request in ms
+
+/*!
+ * \class ModbusSession
+ *
+ * \brief Modbus link session and inverter health tracking
+ *
+ * Slaves are identified by their index in modbusSlaves[].
+ */
+class ModbusSession {
+public:
+    /// Inverter health
+    enum Health : uint8_t {
+        HEALTH_UNKNOWN,         //!< no request since reset/wakeup
+        HEALTH_ALIVE,           //!< last acquisition successful
+        HEALTH_FAILED           //!< last acquisition failed - backoff
+    };
+
+    ModbusSession() {};
+
+    /*!
+     * \brief Open session
+     *
+     * Initializes the Modbus interface if required (first call after
+     * reset/wakeup or re-initialization after link failure).
+     *
+     * \returns time until interface is ready in ms
+     */
+    uint32_t open(void);
+
+    /*!
+     * \brief Time until interface is ready
+     *
+     * \returns remaining settle time after initialization in ms
+     */
+    uint32_t settleTime(void);
+
+    /*!
+     * \brief Check if slave shall be skipped (backoff after failure)
+     *
+     * \param idx  slave index
+     */
+    bool isBackoff(uint8_t idx);
+
+    /*!
+     * \brief Max. number of attempts for acquisition
+     *
+     * \param idx  slave index
+     *
+     * \returns MODBUS_RETRIES, 1 (probe) after failure
+     */
+    uint8_t attempts(uint8_t idx);
+
+    /*!
+     * \brief Delay before retry
+     *
+     * \param retry    no. of retry (0...)
+     *
+     * \returns delay in ms
+     */
+    static uint32_t retryDelay(uint8_t retry);
+
+    /*!
+     * \brief Report result of acquisition
+     *
+     * \param idx      slave index
+     * \param result   growattIF::Success or Modbus error code of last attempt
+     */
+    void result(uint8_t idx, uint8_t result);
+
+    /// Health of slave
+    Health health(uint8_t idx) {
+        return m_slave[idx].health;
+    }
+
+    /// Error code of last failed acquisition of slave
+    uint8_t lastError(uint8_t idx) {
+        return m_slave[idx].error;
+    }
+
+private:
+    /// Per-slave state
+    struct Slave {
+        Health   health = HEALTH_UNKNOWN;
+        uint8_t  fails  = 0;        //!< consecutive failed acquisitions
+        uint8_t  error  = 0;        //!< error code of last failed acquisition
+        uint32_t tFail  = 0;        //!< time of last failed acquisition [ms]
+        uint32_t backoff = 0;       //!< backoff period [ms]
+    };
+
+    Slave    m_slave[MAX_SLAVES];
+    bool     m_open     = false;    //!< interface initialized
+    uint32_t m_tOpen    = 0;        //!< time of initialization [ms]
+    uint8_t  m_failures = 0;        //!< consecutive failed acquisitions (all slaves)
+};
+
+/// Modbus link session
+extern ModbusSession modbusSession;
+
+#endif
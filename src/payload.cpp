@@ -34,6 +34,23 @@
 // 20230314 Created
 // 20230409 Improved serial port reading reliability
 // 20230505 Reordered message contents between port 1 and 2
+// 20261016 Read only the registers required for the uplink port
+//          Added grid capture group (minimal register span)
+//          Replaced blocking get_payload() by plan_payload()/encode_payload(),
+//          Modbus data is acquired by ModbusAcquisition (acquisition.cpp)
+//          encode_payload() encodes data from a snapshot
+//          Added compact fixed-point payload format (PAYLOAD_VERSION 2)
+//          with optional delta encoding of totals (PAYLOAD_DELTA)
+//          Added grouped payload format (multiple ports in one uplink)
+//          Added multi-inverter payload format
+//          Added sample encoding for ring log
+//          Added aggregated data group (PAYLOAD_AGG)
+//          Removed unused ReadInputRegisters()/ReadHoldingRegisters()
+//          (holding registers are cached by settingsCache)
+//          growattInterface pins are taken from board profile
+//          Inverter state registers are read with every acquisition
+//          Totals are encoded from raw register values (no float rounding)
+//          Unconfirmed uplinks keep the delta reference (payload_sent())
 //
 // ToDo:
 // -
@@ -41,157 +58,475 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "payload.h"
+#include "aggregator.h"
 
-growattIF growattInterface(MAX485_RE_NEG, MAX485_DE, MAX485_RX, MAX485_TX);
-//bool holdingregisters = false;
-
-void gen_payload(uint8_t port, LoraEncoder & encoder)
-{
-    const uint8_t     status = 1; // 0: waiting, 1: normal, 3: fault
-    const uint8_t     faultcode = 0;
-    const float       pv1voltage = 60.0; // V
-    const float       pv1current = 2.0; // A
-    const float       pv1power = 120.0; // W
-    const float       outputpower = 111.1; // VA
-    const float       gridvoltage = 233.3; // V
-    const float       gridfrequency = 50.5; // Hz
-    const float       energytoday = 1.11; // kWh
-    const float       energytotal = 444.4; // kWh
-    const float       totalworktime = 15998400; // seconds
-    const float       tempinverter = 22.2; // °C
-    const float       tempipm = 33.3; // °C
-    const float       pv1energytoday = 1.11; // kWh 
-    const float       pv1energytotal = 444.4; // kWh
-    
-    encoder.writeUint8(0x00); // Modbus status
-    if (port == 1) {
-        encoder.writeUint8(status);
-        encoder.writeUint8(faultcode);
-        encoder.writeRawFloat(energytoday);      
-        encoder.writeRawFloat(energytotal);
-        encoder.writeRawFloat(totalworktime);
-        encoder.writeRawFloat(outputpower);
-        encoder.writeRawFloat(gridvoltage);
-        encoder.writeRawFloat(gridfrequency);
-    } else {
-        encoder.writeRawFloat(pv1voltage);
-        encoder.writeRawFloat(pv1current);
-        encoder.writeRawFloat(pv1power);
-        encoder.writeTemperature(tempinverter);
-        encoder.writeTemperature(tempipm);
-        encoder.writeRawFloat(pv1energytoday);
-        encoder.writeRawFloat(pv1energytotal);
-            
+growattIF growattInterface;
+
+// Input registers encoded in uplink port 1
+static const size_t port1Fields[] = {
+    INPUT_FIELD(status),
+    INPUT_FIELD(faultcode),
+    INPUT_FIELD(energytoday),
+    INPUT_FIELD(energytotal),
+    INPUT_FIELD(totalworktime),
+    INPUT_FIELD(outputpower),
+    INPUT_FIELD(gridvoltage),
+    INPUT_FIELD(gridfrequency)
+};
+
+// Input registers encoded in uplink port 2
+static const size_t port2Fields[] = {
+    INPUT_FIELD(pv1voltage),
+    INPUT_FIELD(pv1current),
+    INPUT_FIELD(pv1power),
+    INPUT_FIELD(tempinverter),
+    INPUT_FIELD(tempipm),
+    INPUT_FIELD(pv1energytoday),
+    INPUT_FIELD(pv1energytotal)
+};
+
+// Input registers aggregated between uplinks
+static const size_t aggFields[] = {
+    INPUT_FIELD(outputpower),
+    INPUT_FIELD(pv1power),
+    INPUT_FIELD(gridvoltage)
+};
+
+// Input registers evaluated by the uplink scheduler
+static const size_t stateFields[] = {
+    INPUT_FIELD(status),
+    INPUT_FIELD(outputpower),
+    INPUT_FIELD(deratingmode),
+    INPUT_FIELD(faultcode),
+    INPUT_FIELD(faultbitcode),
+    INPUT_FIELD(warningbitcode)
+};
+
+// Input registers polled by grid capture
+static const size_t captureFields[] = {
+    INPUT_FIELD(outputpower),
+    INPUT_FIELD(gridfrequency),
+    INPUT_FIELD(gridvoltage)
+};
+
+void gen_payload(modbus_input_registers & data)
+{
+    data = {};
+
+    data.status         = 1;        // 0: waiting, 1: normal, 3: fault
+    data.faultcode      = 0;
+    data.pv1voltage     = 60.0;     // V
+    data.pv1current     = 2.0;      // A
+    data.pv1power       = 120.0;    // W
+    data.outputpower    = 111.1;    // VA
+    data.gridvoltage    = 233.3;    // V
+    data.gridfrequency  = 50.5;     // Hz
+    data.energytoday    = 1.11;     // kWh
+    data.energytotal    = 444.4;    // kWh
+    data.totalworktime  = 15998400; // seconds
+    data.tempinverter   = 22.2;     // °C
+    data.tempipm        = 33.3;     // °C
+    data.pv1energytoday = 1.11;     // kWh 
+    data.pv1energytotal = 444.4;    // kWh
+    data.energytotal_raw    = 4444;
+    data.totalworktime_raw  = 31996800;
+    data.pv1energytotal_raw = 4444;
+}
+
+void plan_payload(uint8_t groups)
+{
+    const size_t n1 = sizeof(port1Fields) / sizeof(size_t);
+    const size_t n2 = sizeof(port2Fields) / sizeof(size_t);
+    const size_t n3 = sizeof(aggFields) / sizeof(size_t);
+    const size_t n4 = sizeof(stateFields) / sizeof(size_t);
+    const size_t n5 = sizeof(captureFields) / sizeof(size_t);
+    size_t fields[n1 + n2 + n3 + n4 + n5];
+    size_t n = 0;
+
+    if (groups & PAYLOAD_GROUP(1)) {
+        memcpy(&fields[n], port1Fields, sizeof(port1Fields));
+        n += n1;
+    }
+    if (groups & PAYLOAD_GROUP(2)) {
+        memcpy(&fields[n], port2Fields, sizeof(port2Fields));
+        n += n2;
+    }
+    if (groups & PAYLOAD_GROUP_AGG) {
+        memcpy(&fields[n], aggFields, sizeof(aggFields));
+        n += n3;
     }
+    if (groups & PAYLOAD_GROUP_CAPTURE) {
+        memcpy(&fields[n], captureFields, sizeof(captureFields));
+        n += n5;
+    }
+    if (groups & ~PAYLOAD_GROUP_CAPTURE) {
+        memcpy(&fields[n], stateFields, sizeof(stateFields));
+        n += n4;
+    }
+    growattInterface.planInputRegisters(fields, n, MODBUS_MAX_GAP);
+}
+
+#if (PAYLOAD_VERSION == 2)
+// Scale float value to fixed-point integer
+static inline int32_t fixp(float value, float scale)
+{
+    return lroundf(value * scale);
 }
 
-#if 0
-void ReadInputRegisters() {
-  uint8_t result;
+// Saturate to uint16_t
+static inline uint16_t sat16(int32_t value)
+{
+    return (value < 0) ? 0 : (value > 0xFFFF) ? 0xFFFF : value;
+}
 
-  digitalWrite(STATUS_LED, 0);
+// Reference values for delta encoding of totals
+// Deltas refer to the last acknowledged key frame (absolute values),
+// so a lost delta frame does not affect subsequent frames.
+struct DeltaRef {
+    bool     valid;                 // reference values are valid
+    uint8_t  frames;                // frames since last key frame
+    uint32_t energytotal;           // 0.1 kWh
+    uint32_t totalworktime;         // 0.5 s
+    uint32_t pv1energytotal;        // 0.1 kWh
+};
 
-  result = growattInterface.ReadInputRegisters(NULL);
-  if (result == growattInterface.Success) {
+#if defined(PAYLOAD_DELTA)
+// Reference of last acknowledged uplink per group (retained during deep sleep)
+RTC_DATA_ATTR DeltaRef deltaAcked[PAYLOAD_NUM_GROUPS];
 
-#ifdef DEBUG_SERIAL
-    Serial.println(result);
-#endif
+// Reference of uplink currently being sent per group
+static DeltaRef deltaPending[PAYLOAD_NUM_GROUPS];
 
-  } else if (result != growattInterface.Continue) {
+void payload_ack(uint8_t groups, bool success)
+{
+    for (uint8_t i = 0; i < PAYLOAD_NUM_GROUPS; i++) {
+        if (!(groups & (1 << i)))
+            continue;
+        if (success) {
+            deltaAcked[i] = deltaPending[i];
+        } else {
+            // force key frame
+            deltaAcked[i].valid = false;
+        }
+    }
+}
 
-    Serial.print(F("Error: "));
-    String message = growattInterface.sendModbusError(result);
-    Serial.println(message);
-    delay(5);
-  }
-  digitalWrite(STATUS_LED, 1);
+void payload_sent(uint8_t groups)
+{
+    for (uint8_t i = 0; i < PAYLOAD_NUM_GROUPS; i++) {
+        if ((groups & (1 << i)) && deltaAcked[i].valid && (deltaAcked[i].frames < 0xFF))
+            deltaAcked[i].frames++;
+    }
 }
 
-void ReadHoldingRegisters() {
-  uint8_t result;
+// Select delta or absolute encoding per group and prepare references
+// Returns bitmap of delta encoded groups
+static uint8_t delta_select(uint8_t groups, uint8_t result, const DeltaRef & cur)
+{
+    uint8_t delta = 0;
 
-  digitalWrite(STATUS_LED, 0);
-  result = growattInterface.ReadHoldingRegisters(NULL);
-  if (result == growattInterface.Success)   {
+    for (uint8_t i = 0; i < PAYLOAD_NUM_GROUPS; i++) {
+        if (!(groups & (1 << i)))
+            continue;
 
-#ifdef DEBUG_SERIAL
-    Serial.println(json);
+        DeltaRef &ref     = deltaAcked[i];
+        DeltaRef &pending = deltaPending[i];
+        bool fits;
+
+        if (i == 0) {
+            fits = (cur.energytotal >= ref.energytotal) && (cur.energytotal - ref.energytotal <= 0xFFFF)
+                && (cur.totalworktime >= ref.totalworktime) && (cur.totalworktime - ref.totalworktime <= 0xFFFF);
+        } else {
+            fits = (cur.pv1energytotal >= ref.pv1energytotal) && (cur.pv1energytotal - ref.pv1energytotal <= 0xFFFF);
+        }
+
+        if (ref.valid && (ref.frames < PAYLOAD_KEYFRAME) && fits) {
+            delta |= (1 << i);
+            pending = ref;
+            pending.frames++;
+        } else {
+            pending        = cur;
+            pending.valid  = (result == growattIF::Success);
+            pending.frames = 0;
+        }
+    }
+    return delta;
+}
 #endif
 
-    // Set the flag to true not to read the holding registers again
-    holdingregisters = true;
+// Encode data of one group (see format description below)
+static void encode_group(uint8_t port, const modbus_input_registers & data, const DeltaRef & cur,
+                         const DeltaRef * ref, LoraEncoder & encoder)
+{
+    if (port == 1) {
+        encoder.writeUint8(data.status);
+        encoder.writeUint8(data.faultcode);
+        encoder.writeUint16(sat16(fixp(data.energytoday, 10)));
+        if (ref) {
+            encoder.writeUint16(cur.energytotal - ref->energytotal);
+            encoder.writeUint16(cur.totalworktime - ref->totalworktime);
+        } else {
+            encoder.writeUint32(cur.energytotal);
+            encoder.writeUint32(cur.totalworktime);
+        }
+        encoder.writeUint16(sat16(fixp(data.outputpower, 1)));
+        encoder.writeUint16(sat16(fixp(data.gridvoltage, 10)));
+        encoder.writeUint16(sat16(fixp(data.gridfrequency, 100)));
+    } else {
+        encoder.writeUint16(sat16(fixp(data.pv1voltage, 10)));
+        encoder.writeUint16(sat16(fixp(data.pv1current, 10)));
+        encoder.writeUint16(sat16(fixp(data.pv1power, 1)));
+        encoder.writeUint16(static_cast<int16_t>(fixp(data.tempinverter, 10)));
+        encoder.writeUint16(static_cast<int16_t>(fixp(data.tempipm, 10)));
+        encoder.writeUint16(sat16(fixp(data.pv1energytoday, 10)));
+        if (ref) {
+            encoder.writeUint16(cur.pv1energytotal - ref->pv1energytotal);
+        } else {
+            encoder.writeUint32(cur.pv1energytotal);
+        }
+    }
+}
+
+#if defined(PAYLOAD_AGG)
+// Encode min/max/mean of one channel
+static void encode_channel(const AggChannel & ch, uint16_t count, float scale, LoraEncoder & encoder)
+{
+    encoder.writeUint16(sat16(fixp(ch.min, scale)));
+    encoder.writeUint16(sat16(fixp(ch.max, scale)));
+    encoder.writeUint16(sat16(fixp(ch.sum / count, scale)));
+}
 
-  } else if (result != growattInterface.Continue) {
-    Serial.print(F("Error: "));
-    String message = growattInterface.sendModbusError(result);
-    Serial.println(message);
+// Encode aggregated data since last uplink and start new interval
+static void encode_agg(LoraEncoder & encoder)
+{
+    AggSummary sum;
 
-    delay(5);
-  }
-  digitalWrite(STATUS_LED, 1);
+    aggregator.take(sum);
+    log_d("Aggregated: %u samples, %u s", sum.count, (unsigned)(sum.duration / 1000));
+    encoder.writeUint16(sum.count);
+    encoder.writeUint16(sat16(sum.duration / 1000));
+    if (sum.count == 0) {
+        // no samples - all values are zero
+        for (int i = 0; i < 11; i++)
+            encoder.writeUint16(0);
+        return;
+    }
+    encode_channel(sum.outputpower, sum.count, 1, encoder);
+    encoder.writeUint16(sat16(fixp(sum.outputenergy, 1)));
+    encode_channel(sum.pv1power, sum.count, 1, encoder);
+    encoder.writeUint16(sat16(fixp(sum.pv1energy, 1)));
+    encode_channel(sum.gridvoltage, sum.count, 10, encoder);
 }
 #endif
 
-void get_payload(uint8_t port, LoraEncoder & encoder)
+// Encode header and all selected groups
+static void encode_frame(uint8_t header, uint8_t groups, uint8_t result,
+                         const modbus_input_registers & data, LoraEncoder & encoder)
 {
-    uint8_t result;
-    
-    growattInterface.initGrowatt();
-    delay(500);
-    /*
-    if (!holdingregisters) {
-      // Read the holding registers
-      ReadHoldingRegisters();
+    uint8_t  delta = 0;
+    DeltaRef cur;
+
+    // raw register values - exact for any value (see growattRegisters.h)
+    cur.energytotal    = data.energytotal_raw;
+    cur.totalworktime  = data.totalworktime_raw;
+    cur.pv1energytotal = data.pv1energytotal_raw;
+
+    #if defined(PAYLOAD_DELTA)
+        delta = delta_select(groups, result, cur);
+    #endif
+
+    if (header == PAYLOAD_HEADER_V2) {
+        // single group: delta flag in bit 0
+        encoder.writeUint8(header | (delta ? PAYLOAD_FLAG_DELTA : 0));
+        encoder.writeUint8(result);
     } else {
-      // Read the input registers
-      ReadInputRegisters();
+        // multiple groups: delta flag per group
+        encoder.writeUint8(header | delta);
+        encoder.writeUint8(result);
+        encoder.writeUint8(groups);
     }
-    */
-    
-    int retries=0;
-    do {
-        result = growattInterface.ReadInputRegisters(NULL);
-        log_d("ReadInputRegisters: 0x%02x", result);
-        if ((result != growattInterface.Continue) && (result != growattInterface.Success)) {
-            String message = growattInterface.sendModbusError(result);
-            log_e("Error: %s", message.c_str());
+    if (result != growattIF::Success)
+        return;
+
+    for (uint8_t i = 0; i < PAYLOAD_NUM_GROUPS; i++) {
+        if (groups & (1 << i)) {
+            const DeltaRef *ref = nullptr;
+            #if defined(PAYLOAD_DELTA)
+                if (delta & (1 << i))
+                    ref = &deltaAcked[i];
+            #endif
+            encode_group(i + 1, data, cur, ref, encoder);
         }
-        while (result == growattInterface.Continue) {
-            delay(1000);
-            result = growattInterface.ReadInputRegisters(NULL);
-            String message = growattInterface.sendModbusError(result);
-            if (result != growattInterface.Continue && (result != growattInterface.Success)) {
-                log_e("Error: %s", message.c_str());
-                delay(1000);
-            } else {
-                log_d("%s", message.c_str());
-            }
+    }
+    #if defined(PAYLOAD_AGG)
+        if (groups & PAYLOAD_GROUP_AGG)
+            encode_agg(encoder);
+    #endif
+}
+
+/*
+ * Compact payload format (version 2)
+ *
+ * All values are native fixed-point integers (little endian).
+ *
+ * byte 0: header - 0x20 | flags (bit 0: totals are delta encoded)
+ * byte 1: Modbus result
+ *
+ * Port 1:
+ * uint8   status
+ * uint8   faultcode
+ * uint16  energytoday     [0.1 kWh]
+ * uint32  energytotal     [0.1 kWh] / uint16 delta
+ * uint32  totalworktime   [0.5 s]   / uint16 delta
+ * uint16  outputpower     [1 W]
+ * uint16  gridvoltage     [0.1 V]
+ * uint16  gridfrequency   [0.01 Hz]
+ *
+ * Port 2:
+ * uint16  pv1voltage      [0.1 V]
+ * uint16  pv1current      [0.1 A]
+ * uint16  pv1power        [1 W]
+ * int16   tempinverter    [0.1 °C]
+ * int16   tempipm         [0.1 °C]
+ * uint16  pv1energytoday  [0.1 kWh]
+ * uint32  pv1energytotal  [0.1 kWh] / uint16 delta
+ */
+void encode_payload(uint8_t port, uint8_t result, const modbus_input_registers & data, LoraEncoder & encoder)
+{
+    log_v("Port: %d", port);
+    encode_frame(PAYLOAD_HEADER_V2, PAYLOAD_GROUP(port), result, data, encoder);
+}
+
+/*
+ * Grouped payload format (version 3)
+ *
+ * byte 0: header - 0x30 | flags (bit n: totals of group n are delta encoded)
+ * byte 1: Modbus result
+ * byte 2: group bitmap (bit 0: port 1 data, bit 1: port 2 data,
+ *         bit 2: aggregated data)
+ * byte 3...: group data in ascending order, each as in version 2
+ *
+ * Aggregated data (PAYLOAD_AGG; since previous uplink):
+ * uint16  no. of samples
+ * uint16  duration        [1 s]
+ * uint16  outputpower     min/max/mean [1 W]
+ * uint16  outputenergy    [1 Wh]
+ * uint16  pv1power        min/max/mean [1 W]
+ * uint16  pv1energy       [1 Wh]
+ * uint16  gridvoltage     min/max/mean [0.1 V]
+ */
+void encode_groups(uint8_t groups, uint8_t result, const modbus_input_registers & data, LoraEncoder & encoder)
+{
+    log_v("Groups: 0x%02X", groups);
+    encode_frame(PAYLOAD_HEADER_V3, groups, result, data, encoder);
+}
+
+/*
+ * Multi-inverter payload format (port PAYLOAD_PORT_SLAVES)
+ *
+ * byte 0: no. of inverters
+ *
+ * Per inverter:
+ * uint8   slave ID
+ * uint8   Modbus result
+ * (only if result is Success:)
+ * uint8   status
+ * uint8   faultcode
+ * uint16  outputpower     [1 W]
+ * uint16  energytoday     [0.1 kWh]
+ * uint32  energytotal     [0.1 kWh]
+ */
+uint8_t encode_slaves(const uint8_t *ids, const Snapshot *snaps, uint8_t n, uint8_t maxSize, LoraEncoder & encoder)
+{
+    uint8_t size  = 1;
+    uint8_t count = 0;
+
+    // no. of inverters which fit into payload
+    while (count < n) {
+        size += (snaps[count].result == growattIF::Success) ? 12 : 2;
+        if (size > maxSize)
+            break;
+        count++;
+    }
+
+    encoder.writeUint8(count);
+    for (uint8_t i = 0; i < count; i++) {
+        encoder.writeUint8(ids[i]);
+        encoder.writeUint8(snaps[i].result);
+        if (snaps[i].result == growattIF::Success) {
+            encoder.writeUint8(snaps[i].data.status);
+            encoder.writeUint8(snaps[i].data.faultcode);
+            encoder.writeUint16(sat16(fixp(snaps[i].data.outputpower, 1)));
+            encoder.writeUint16(sat16(fixp(snaps[i].data.energytoday, 10)));
+            encoder.writeUint32(snaps[i].data.energytotal_raw);
         }
-    } while ((result != growattInterface.Success) && (++retries < MODBUS_RETRIES));
-    
+    }
+    return count;
+}
+
+/*
+ * Ring log sample (backfill payload, port PAYLOAD_PORT_BACKFILL)
+ *
+ * uint32  energytotal     [0.1 kWh]
+ * uint16  energytoday     [0.1 kWh]
+ * uint16  outputpower     [1 W]
+ * uint32  pv1energytotal  [0.1 kWh]
+ * uint8   status
+ * uint8   faultcode
+ */
+uint8_t encode_sample(const modbus_input_registers & data, uint8_t *buf)
+{
+    LoraEncoder encoder(buf);
+
+    encoder.writeUint32(data.energytotal_raw);
+    encoder.writeUint16(sat16(fixp(data.energytoday, 10)));
+    encoder.writeUint16(sat16(fixp(data.outputpower, 1)));
+    encoder.writeUint32(data.pv1energytotal_raw);
+    encoder.writeUint8(data.status);
+    encoder.writeUint8(data.faultcode);
+    return SAMPLE_SIZE;
+}
+
+uint8_t payload_size(uint8_t groups)
+{
+    // header + Modbus result + group bitmap
+    uint8_t size = 3;
+
+    if (groups & PAYLOAD_GROUP(1))
+        size += 18;
+    if (groups & PAYLOAD_GROUP(2))
+        size += 16;
+    if (groups & PAYLOAD_GROUP_AGG)
+        size += AGG_SIZE;
+    return size;
+}
+
+#else
+void encode_payload(uint8_t port, uint8_t result, const modbus_input_registers & data, LoraEncoder & encoder)
+{
     encoder.writeUint8(result);
-    if (result == growattInterface.Success) {
+    if (result == growattIF::Success) {
         log_v("Port: %d", port);
         if (port == 1) {
-            encoder.writeUint8(growattInterface.modbusdata.status);
-            encoder.writeUint8(growattInterface.modbusdata.faultcode);
-            encoder.writeRawFloat(growattInterface.modbusdata.energytoday);      
-            encoder.writeRawFloat(growattInterface.modbusdata.energytotal);
-            encoder.writeRawFloat(growattInterface.modbusdata.totalworktime);
-            encoder.writeRawFloat(growattInterface.modbusdata.outputpower);
-            encoder.writeRawFloat(growattInterface.modbusdata.gridvoltage);
-            encoder.writeRawFloat(growattInterface.modbusdata.gridfrequency);
+            encoder.writeUint8(data.status);
+            encoder.writeUint8(data.faultcode);
+            encoder.writeRawFloat(data.energytoday);      
+            encoder.writeRawFloat(data.energytotal);
+            encoder.writeRawFloat(data.totalworktime);
+            encoder.writeRawFloat(data.outputpower);
+            encoder.writeRawFloat(data.gridvoltage);
+            encoder.writeRawFloat(data.gridfrequency);
         
         } else {
-            encoder.writeRawFloat(growattInterface.modbusdata.pv1voltage);
-            encoder.writeRawFloat(growattInterface.modbusdata.pv1current);
-            encoder.writeRawFloat(growattInterface.modbusdata.pv1power);
-            encoder.writeTemperature(growattInterface.modbusdata.tempinverter);
-            encoder.writeTemperature(growattInterface.modbusdata.tempipm);
-            encoder.writeRawFloat(growattInterface.modbusdata.pv1energytoday);
-            encoder.writeRawFloat(growattInterface.modbusdata.pv1energytotal);
+            encoder.writeRawFloat(data.pv1voltage);
+            encoder.writeRawFloat(data.pv1current);
+            encoder.writeRawFloat(data.pv1power);
+            encoder.writeTemperature(data.tempinverter);
+            encoder.writeTemperature(data.tempipm);
+            encoder.writeRawFloat(data.pv1energytoday);
+            encoder.writeRawFloat(data.pv1energytotal);
         
         }
     }
 }
+#endif
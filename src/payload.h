@@ -32,6 +32,16 @@
 // History:
 //
 // 20230314 Created
+// 20261016 Split get_payload() into plan_payload() and encode_payload()
+//          encode_payload() encodes data from a snapshot
+//          Added compact fixed-point payload format
+//          Added grouped payload format
+//          Added multi-inverter payload format
+//          Added sample encoding for ring log
+//          Added aggregated data group (PAYLOAD_AGG)
+//          Added inverter state group (uplink scheduler)
+//          Added grid capture group (CAPTURE_EN)
+//          Added payload_sent() for unconfirmed uplinks
 //
 // ToDo:
 // -
@@ -41,6 +51,108 @@
 #include <LoraMessage.h>
 #include "settings.h"
 #include "growattInterface.h"
+#include "snapshot.h"
 
-void gen_payload(uint8_t port, LoraEncoder & encoder);
-void get_payload(uint8_t port, LoraEncoder & encoder);
+#define PAYLOAD_NUM_GROUPS  2                       // number of data groups (ports 1 and 2)
+#define PAYLOAD_GROUP(port) (1 << ((port) - 1))         // group bit of uplink port
+#define PAYLOAD_GROUPS_ALL  ((1 << PAYLOAD_NUM_GROUPS) - 1)
+#define PAYLOAD_GROUP_AGG   (1 << PAYLOAD_NUM_GROUPS)   // aggregated data (grouped payload format only)
+#define PAYLOAD_GROUP_STATE (1 << (PAYLOAD_NUM_GROUPS + 1)) // inverter state only (no uplink, see uplinkScheduler.h)
+#define PAYLOAD_GROUP_CAPTURE (1 << (PAYLOAD_NUM_GROUPS + 2)) // grid capture only (first slave, see gridCapture.h)
+#define AGG_SIZE            26                          // size of aggregated data in bytes
+
+extern growattIF growattInterface;
+
+/*!
+ * \brief Generate simulated input register data (for debugging)
+ *
+ * \param data input register data
+ */
+void gen_payload(modbus_input_registers & data);
+
+/*!
+ * \brief Select the Modbus registers required for uplink data groups
+ *
+ * The registers evaluated by the uplink scheduler are always included.
+ *
+ * \param groups group bitmap (see PAYLOAD_GROUP())
+ */
+void plan_payload(uint8_t groups);
+
+/*!
+ * \brief Encode Modbus data for an uplink port
+ *
+ * \param port     uplink port
+ * \param result   result of Modbus data acquisition
+ * \param data     input register data
+ * \param encoder  LoRaWAN payload encoder
+ */
+void encode_payload(uint8_t port, uint8_t result, const modbus_input_registers & data, LoraEncoder & encoder);
+
+#if (PAYLOAD_VERSION == 2)
+/*!
+ * \brief Encode Modbus data of multiple groups into a single uplink
+ *
+ * \param groups   group bitmap (see PAYLOAD_GROUP())
+ * \param result   result of Modbus data acquisition
+ * \param data     input register data
+ * \param encoder  LoRaWAN payload encoder
+ */
+void encode_groups(uint8_t groups, uint8_t result, const modbus_input_registers & data, LoraEncoder & encoder);
+
+/*!
+ * \brief Get max. size of grouped payload
+ *
+ * \param groups group bitmap (see PAYLOAD_GROUP())
+ *
+ * \returns payload size in bytes
+ */
+uint8_t payload_size(uint8_t groups);
+
+/*!
+ * \brief Encode summary data of multiple inverters into a single uplink
+ *
+ * Inverters which do not fit into maxSize are omitted.
+ *
+ * \param ids      slave IDs
+ * \param snaps    Modbus data snapshot of each slave
+ * \param n        no. of slaves
+ * \param maxSize  max. payload size
+ * \param encoder  LoRaWAN payload encoder
+ *
+ * \returns no. of inverters encoded
+ */
+uint8_t encode_slaves(const uint8_t *ids, const Snapshot *snaps, uint8_t n, uint8_t maxSize, LoraEncoder & encoder);
+
+#define SAMPLE_SIZE 14      // size of encoded sample in bytes
+
+/*!
+ * \brief Encode sample for ring log / backfill uplink
+ *
+ * \param data     input register data
+ * \param buf      buffer (SAMPLE_SIZE bytes)
+ *
+ * \returns sample size in bytes
+ */
+uint8_t encode_sample(const modbus_input_registers & data, uint8_t *buf);
+#endif
+
+#if defined(PAYLOAD_DELTA)
+/*!
+ * \brief Update delta encoding reference after confirmed uplink has been completed
+ *
+ * \param groups   group bitmap (see PAYLOAD_GROUP())
+ * \param success  uplink has been acknowledged
+ */
+void payload_ack(uint8_t groups, bool success);
+
+/*!
+ * \brief Update delta encoding state after unconfirmed uplink has been sent
+ *
+ * Reception is unknown, so the reference is kept; only the frame counter
+ * is advanced, i.e. a key frame is still sent every PAYLOAD_KEYFRAME frames.
+ *
+ * \param groups   group bitmap (see PAYLOAD_GROUP())
+ */
+void payload_sent(uint8_t groups);
+#endif
@@ -0,0 +1,129 @@
+///////////////////////////////////////////////////////////////////////////////
+// powerLimit.cpp
+//
+// Remote active power limitation (holding register maxoutputactivepp)
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "powerLimit.h"
+#include "growattInterface.h"
+
+PowerLimit powerLimit;
+
+/// Request state - in RTC RAM to survive deep sleep
+struct PowerLimitState {
+    bool     pending;           //!< request pending
+    bool     report;            //!< result to be reported
+    bool     attempted;         //!< tLast is valid
+    uint8_t  target;            //!< requested value [%]
+    uint8_t  attempts;          //!< no. of failed attempts
+    uint8_t  result;            //!< result of last attempt
+    uint8_t  value;             //!< value read back [%]
+    time_t   tLast;             //!< time of last attempt
+};
+
+RTC_DATA_ATTR static PowerLimitState limitState;
+
+bool PowerLimit::request(uint8_t pct)
+{
+    if ((pct > 100) && (pct != POWER_LIMIT_NONE))
+        return false;
+
+    portENTER_CRITICAL(&m_mux);
+    limitState.target   = pct;
+    limitState.attempts = 0;
+    limitState.pending  = true;
+    portEXIT_CRITICAL(&m_mux);
+    return true;
+}
+
+bool PowerLimit::isDue(void)
+{
+    return limitState.pending &&
+           (!limitState.attempted || (time(nullptr) - limitState.tLast >= POWER_LIMIT_INTERVAL));
+}
+
+uint8_t PowerLimit::target(void)
+{
+    return limitState.target;
+}
+
+void PowerLimit::done(uint8_t pct, uint8_t result, uint16_t value)
+{
+    portENTER_CRITICAL(&m_mux);
+    limitState.attempted = true;
+    limitState.tLast     = time(nullptr);
+    if (pct != limitState.target) {
+        // superseded by new request - try again with new value
+        portEXIT_CRITICAL(&m_mux);
+        return;
+    }
+    limitState.result = result;
+    limitState.value  = (value > UINT8_MAX) ? UINT8_MAX : value;
+    if ((result == growattIF::Success) || (++limitState.attempts >= POWER_LIMIT_RETRIES)) {
+        limitState.pending = false;
+        limitState.report  = true;
+    }
+    portEXIT_CRITICAL(&m_mux);
+
+    if (result == growattIF::Success) {
+        log_i("Power limit set to %u %%", pct);
+    } else {
+        log_w("Setting power limit to %u %% failed (0x%02X, read back: %u)", pct, result, value);
+    }
+}
+
+bool PowerLimit::hasReport(void)
+{
+    return limitState.report;
+}
+
+/*
+ * Power limit result (FPort 6)
+ *
+ * byte 0: result (0: success, 0xFE: read-back value differs, other: Modbus error)
+ * byte 1: requested value [%] (255: not limited)
+ * byte 2: value read back from inverter [%]
+ */
+void PowerLimit::encode(LoraEncoder &encoder)
+{
+    portENTER_CRITICAL(&m_mux);
+    encoder.writeUint8(limitState.result);
+    encoder.writeUint8(limitState.target);
+    encoder.writeUint8(limitState.value);
+    limitState.report = false;
+    portEXIT_CRITICAL(&m_mux);
+}
@@ -0,0 +1,123 @@
+///////////////////////////////////////////////////////////////////////////////
+// powerLimit.h
+//
+// Remote active power limitation (holding register maxoutputactivepp)
+//
+// A power limit requested by downlink (CMD_SET_POWER_LIMIT) is written by the
+// Modbus acquisition between input register reads and verified by reading
+// the register back. Repeated requests are coalesced - only the latest
+// value is written, and only if it differs from the inverter's value.
+// Write attempts are rate limited (POWER_LIMIT_INTERVAL) to protect the
+// inverter's EEPROM. The result is reported by uplink (FPort 6).
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef POWER_LIMIT_H
+#define POWER_LIMIT_H
+
+#include "Arduino.h"
+#include <LoraMessage.h>
+#include "settings.h"
+
+#define POWER_LIMIT_NONE        255     //!< maxoutputactivepp: not limited
+#define POWER_LIMIT_SIZE        3       //!< size of FPort 6 payload
+
+/*!
+ * \class PowerLimit
+ *
+ * \brief Pending power limit request
+ */
+class PowerLimit {
+public:
+    /// Result: read-back value differs from requested value
+    static const uint8_t VerifyFailed = 0xFE;
+
+    PowerLimit() {};
+
+    /*!
+     * \brief Request power limit
+     *
+     * \param pct      max. output active power [%] (0...100, POWER_LIMIT_NONE)
+     *
+     * \returns false if value is invalid
+     */
+    bool request(uint8_t pct);
+
+    /*!
+     * \brief Check if a write attempt is due
+     *
+     * \returns true if a request is pending and the rate limit allows writing
+     */
+    bool isDue(void);
+
+    /*!
+     * \brief Get requested value
+     *
+     * \returns max. output active power [%]
+     */
+    uint8_t target(void);
+
+    /*!
+     * \brief Finish write attempt
+     *
+     * \param pct      value which was written/checked
+     * \param result   Modbus result (or VerifyFailed)
+     * \param value    value read back from inverter
+     */
+    void done(uint8_t pct, uint8_t result, uint16_t value);
+
+    /*!
+     * \brief Check if a result is to be reported
+     *
+     * \returns true if report uplink is pending
+     */
+    bool hasReport(void);
+
+    /*!
+     * \brief Encode result (FPort 6) and clear report request
+     *
+     * \param encoder  LoraEncoder object
+     */
+    void encode(LoraEncoder &encoder);
+
+private:
+    portMUX_TYPE m_mux = portMUX_INITIALIZER_UNLOCKED;
+};
+
+/// Power limit request
+extern PowerLimit powerLimit;
+
+#endif
@@ -0,0 +1,157 @@
+///////////////////////////////////////////////////////////////////////////////
+// rbe.cpp
+//
+// Report by exception - suppress uplinks of unchanged data
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "rbe.h"
+#include "payload.h"
+
+#if defined(RBE_EN)
+
+/// Field of input register data compared to deadband
+struct RbeField {
+    size_t  offset;             //!< offset in modbus_input_registers
+    float   scale;              //!< deadband units per register unit
+    uint8_t group;              //!< data group
+};
+
+static const RbeField rbeFields[RBE_NUM_FIELDS] = {
+    {INPUT_FIELD(outputpower),    1,   PAYLOAD_GROUP(1)},
+    {INPUT_FIELD(gridvoltage),    10,  PAYLOAD_GROUP(1)},
+    {INPUT_FIELD(gridfrequency),  100, PAYLOAD_GROUP(1)},
+    {INPUT_FIELD(energytoday),    10,  PAYLOAD_GROUP(1)},
+    {INPUT_FIELD(pv1voltage),     10,  PAYLOAD_GROUP(2)},
+    {INPUT_FIELD(pv1current),     10,  PAYLOAD_GROUP(2)},
+    {INPUT_FIELD(pv1power),       1,   PAYLOAD_GROUP(2)},
+    {INPUT_FIELD(tempinverter),   10,  PAYLOAD_GROUP(2)},
+    {INPUT_FIELD(tempipm),        10,  PAYLOAD_GROUP(2)},
+    {INPUT_FIELD(pv1energytoday), 10,  PAYLOAD_GROUP(2)}
+};
+
+/// Reference data of one group
+struct RbeRef {
+    bool    valid;              //!< reference data valid
+    uint8_t result;             //!< Modbus result
+    int     status;             //!< inverter status
+    int     faultcode;          //!< fault code
+    float   value[RBE_NUM_FIELDS]; //!< field values
+    uint8_t silent;             //!< no. of consecutive suppressed uplinks
+};
+
+// Reference data (last successful uplink) and pending data (uplink in progress)
+// of each group - in RTC RAM to survive deep sleep
+RTC_DATA_ATTR static RbeRef rbeRef[PAYLOAD_NUM_GROUPS];
+RTC_DATA_ATTR static RbeRef rbePending[PAYLOAD_NUM_GROUPS];
+
+static uint16_t rbeDeadband[RBE_NUM_FIELDS] = RBE_DEADBAND;
+static uint8_t  rbeHeartbeat = RBE_HEARTBEAT;
+
+static inline float field(const modbus_input_registers &data, size_t offset)
+{
+    return *reinterpret_cast<const float *>(reinterpret_cast<const uint8_t *>(&data) + offset);
+}
+
+void rbe_config(const uint16_t *deadband, uint8_t heartbeat)
+{
+    memcpy(rbeDeadband, deadband, sizeof(rbeDeadband));
+    rbeHeartbeat = heartbeat;
+}
+
+// Check if data of group has changed with respect to reference
+static bool changed(uint8_t group, const RbeRef &ref, const RbeRef &cur)
+{
+    if (!ref.valid || (cur.result != ref.result))
+        return true;
+    if (cur.result != growattIF::Success)
+        return false;
+    if ((cur.status != ref.status) || (cur.faultcode != ref.faultcode))
+        return true;
+
+    for (uint8_t i = 0; i < RBE_NUM_FIELDS; i++) {
+        if (!(rbeFields[i].group & group) || (rbeDeadband[i] == RBE_IGNORE))
+            continue;
+        if (lroundf(fabsf(cur.value[i] - ref.value[i]) * rbeFields[i].scale) > rbeDeadband[i]) {
+            log_v("Field %u changed", i);
+            return true;
+        }
+    }
+    return false;
+}
+
+uint8_t rbe_filter(uint8_t groups, uint8_t result, const modbus_input_registers &data)
+{
+    uint8_t send = groups & ~PAYLOAD_GROUPS_ALL;
+    RbeRef  cur;
+
+    cur.valid     = true;
+    cur.result    = result;
+    cur.status    = data.status;
+    cur.faultcode = data.faultcode;
+    cur.silent    = 0;
+    for (uint8_t i = 0; i < RBE_NUM_FIELDS; i++)
+        cur.value[i] = field(data, rbeFields[i].offset);
+
+    for (uint8_t g = 0; g < PAYLOAD_NUM_GROUPS; g++) {
+        if (!(groups & (1 << g)))
+            continue;
+        RbeRef &ref = rbeRef[g];
+        if ((rbeHeartbeat == 0) || (ref.silent >= rbeHeartbeat) || changed(1 << g, ref, cur)) {
+            send |= 1 << g;
+            rbePending[g] = cur;
+        } else {
+            ref.silent++;
+            log_d("Group %u unchanged - suppressed (%u/%u)", g + 1, ref.silent, rbeHeartbeat);
+        }
+    }
+
+    // no data group left - skip uplink
+    return (send & PAYLOAD_GROUPS_ALL) ? send : 0;
+}
+
+void rbe_ack(uint8_t groups, bool success)
+{
+    if (!success)
+        return;
+
+    for (uint8_t g = 0; g < PAYLOAD_NUM_GROUPS; g++) {
+        if (groups & (1 << g))
+            rbeRef[g] = rbePending[g];
+    }
+}
+
+#endif
@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////
+// rbe.h
+//
+// Report by exception - suppress uplinks of unchanged data
+//
+// The data of each uplink group is compared to the data of the last
+// successful uplink of that group. A group is only sent if the Modbus result,
+// the status or the faultcode has changed or if a value has changed by more
+// than its deadband. Unchanged groups are removed from grouped uplinks; an
+// uplink is skipped if no group is left. A group is sent at least after
+// <heartbeat> suppressed uplinks.
+//
+// Deadbands and heartbeat can be configured by downlink
+// (CMD_SET_DEADBAND, CMD_SET_HEARTBEAT).
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef RBE_H
+#define RBE_H
+
+#include "Arduino.h"
+#include "settings.h"
+#include "growattRegisters.h"
+
+/*
+ * Deadband fields (index used by CMD_SET_DEADBAND)
+ *
+ * idx  field           unit      group
+ * 0    outputpower     1 W       1
+ * 1    gridvoltage     0.1 V     1
+ * 2    gridfrequency   0.01 Hz   1
+ * 3    energytoday     0.1 kWh   1
+ * 4    pv1voltage      0.1 V     2
+ * 5    pv1current      0.1 A     2
+ * 6    pv1power        1 W       2
+ * 7    tempinverter    0.1 °C    2
+ * 8    tempipm         0.1 °C    2
+ * 9    pv1energytoday  0.1 kWh   2
+ */
+#define RBE_NUM_FIELDS  10
+
+/// Deadband value: field is ignored
+#define RBE_IGNORE      0xFFFF
+
+/*!
+ * \brief Set deadbands and heartbeat
+ *
+ * \param deadband   deadband per field (RBE_NUM_FIELDS entries, see above)
+ * \param heartbeat  max. no. of consecutive suppressed uplinks per group
+ *                   (0: report by exception disabled)
+ */
+void rbe_config(const uint16_t *deadband, uint8_t heartbeat);
+
+/*!
+ * \brief Select data groups which have changed since the last successful uplink
+ *
+ * Groups which are not selected are counted as suppressed.
+ *
+ * \param groups     due data groups (bitmap)
+ * \param result     Modbus result
+ * \param data       input register data
+ *
+ * \returns data groups to be sent (0: skip uplink)
+ */
+uint8_t rbe_filter(uint8_t groups, uint8_t result, const modbus_input_registers &data);
+
+/*!
+ * \brief Update reference data after uplink
+ *
+ * \param groups     data groups of uplink
+ * \param success    uplink result
+ */
+void rbe_ack(uint8_t groups, bool success);
+
+#endif
@@ -0,0 +1,257 @@
+///////////////////////////////////////////////////////////////////////////////
+// regSerializer.cpp
+//
+// Streaming JSON/CBOR serializer for Growatt register data
+//
+// The output is generated in a single pass over the register descriptor
+// tables (see growattRegisters.h) into a caller-provided buffer of fixed
+// size - no heap, no String objects. Output which does not fit into the
+// buffer is discarded and reported as overflow.
+// This file does not depend on the Arduino framework and can be compiled
+// on the host.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "regSerializer.h"
+
+RegSerializer::RegSerializer(RegFormat fmt, uint8_t *buf, size_t size)
+  : m_fmt(fmt), m_buf(buf), m_size(size), m_pos(0), m_overflow(false), m_sep(false)
+{
+  if (m_size == 0) {
+    m_buf      = nullptr;
+    m_overflow = true;
+  } else if (m_fmt == FMT_JSON) {
+    // reserve space for NUL
+    m_size--;
+  }
+}
+
+void RegSerializer::put(uint8_t c)
+{
+  if (m_pos < m_size) {
+    m_buf[m_pos++] = c;
+  } else {
+    m_overflow = true;
+  }
+}
+
+void RegSerializer::put(const char *s, size_t len)
+{
+  if (len > m_size - m_pos) {
+    m_overflow = true;
+    return;
+  }
+  if (len == 0)
+    return;
+  memcpy(&m_buf[m_pos], s, len);
+  m_pos += len;
+}
+
+// CBOR initial byte and argument (big-endian)
+void RegSerializer::cborHead(uint8_t major, uint32_t v)
+{
+  major <<= 5;
+  if (v < 24) {
+    put(major | v);
+  } else if (v <= 0xff) {
+    put(major | 24);
+    put(v);
+  } else if (v <= 0xffff) {
+    put(major | 25);
+    put(v >> 8);
+    put(v & 0xff);
+  } else {
+    put(major | 26);
+    for (int i = 24; i >= 0; i -= 8)
+      put((v >> i) & 0xff);
+  }
+}
+
+void RegSerializer::separator(void)
+{
+  if (m_sep)
+    put(',');
+  m_sep = true;
+}
+
+void RegSerializer::beginMap(size_t n)
+{
+  if (m_fmt == FMT_CBOR) {
+    cborHead(5, n);
+  } else {
+    put('{');
+    m_sep = false;
+  }
+}
+
+void RegSerializer::endMap(void)
+{
+  if (m_fmt == FMT_JSON) {
+    put('}');
+    m_sep = true;
+  }
+}
+
+void RegSerializer::key(const char *k)
+{
+  size_t len = strlen(k);
+
+  if (m_fmt == FMT_CBOR) {
+    cborHead(3, len);
+    put(k, len);
+  } else {
+    separator();
+    put('"');
+    put(k, len);
+    put('"');
+    put(':');
+  }
+}
+
+void RegSerializer::value(int32_t v)
+{
+  if (m_fmt == FMT_CBOR) {
+    if (v < 0) {
+      cborHead(1, static_cast<uint32_t>(-(v + 1)));
+    } else {
+      cborHead(0, v);
+    }
+  } else {
+    char tmp[12];
+    int  len = snprintf(tmp, sizeof(tmp), "%ld", static_cast<long>(v));
+    put(tmp, len);
+  }
+}
+
+void RegSerializer::value(uint32_t v)
+{
+  if (m_fmt == FMT_CBOR) {
+    cborHead(0, v);
+  } else {
+    char tmp[12];
+    int  len = snprintf(tmp, sizeof(tmp), "%lu", static_cast<unsigned long>(v));
+    put(tmp, len);
+  }
+}
+
+void RegSerializer::value(float v, uint8_t decimals)
+{
+  if (m_fmt == FMT_CBOR) {
+    // single precision float
+    uint32_t raw;
+    memcpy(&raw, &v, sizeof(raw));
+    put(0xfa);
+    for (int i = 24; i >= 0; i -= 8)
+      put((raw >> i) & 0xff);
+  } else if (!isfinite(v)) {
+    put("null", 4);
+  } else {
+    char tmp[24];
+    int  len = snprintf(tmp, sizeof(tmp), "%.*f", decimals, v);
+    if ((len < 0) || (len >= static_cast<int>(sizeof(tmp)))) {
+      m_overflow = true;
+      return;
+    }
+    put(tmp, len);
+  }
+}
+
+void RegSerializer::value(const char *s, size_t maxLen)
+{
+  size_t len = strnlen(s, maxLen);
+
+  if (m_fmt == FMT_CBOR) {
+    cborHead(3, len);
+  } else {
+    put('"');
+  }
+  for (size_t i = 0; i < len; i++) {
+    unsigned char c = s[i];
+    if ((c < 0x20) || (c > 0x7e) || (m_fmt == FMT_JSON && (c == '"' || c == '\\'))) {
+      // keep CBOR length and JSON syntax valid
+      c = '?';
+    }
+    put(c);
+  }
+  if (m_fmt == FMT_JSON)
+    put('"');
+}
+
+// Number of decimals required by scale factor
+static uint8_t decimals(float scale)
+{
+  if (scale >= 1.0f)
+    return 0;
+  if (scale >= 0.1f)
+    return 1;
+  return 2;
+}
+
+void RegSerializer::registers(const RegDesc *table, size_t n, const void *data)
+{
+  const uint8_t *base = static_cast<const uint8_t *>(data);
+
+  beginMap(n);
+  for (size_t i = 0; i < n && !m_overflow; i++) {
+    const RegDesc &d = table[i];
+
+    key(d.name);
+    if (d.type == REG_STR) {
+      value(reinterpret_cast<const char *>(base + d.offset), 2 * d.width);
+    } else if (d.type == REG_FLOAT) {
+      value(*reinterpret_cast<const float *>(base + d.offset), decimals(d.scale));
+    } else {
+      int v = *reinterpret_cast<const int *>(base + d.offset);
+      if (d.sign) {
+        value(static_cast<int32_t>(v));
+      } else {
+        // e.g. 32-bit fault bit codes
+        value(static_cast<uint32_t>(v));
+      }
+    }
+  }
+  endMap();
+}
+
+size_t RegSerializer::finish(void)
+{
+  if ((m_fmt == FMT_JSON) && (m_buf != nullptr))
+    m_buf[m_overflow ? 0 : m_pos] = '\0';
+  return m_overflow ? 0 : m_pos;
+}
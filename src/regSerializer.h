@@ -0,0 +1,173 @@
+///////////////////////////////////////////////////////////////////////////////
+// regSerializer.h
+//
+// Streaming JSON/CBOR serializer for Growatt register data
+//
+// The output is generated in a single pass over the register descriptor
+// tables (see growattRegisters.h) into a caller-provided buffer of fixed
+// size - no heap, no String objects. Output which does not fit into the
+// buffer is discarded and reported as overflow.
+// This file does not depend on the Arduino framework and can be compiled
+// on the host.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef REG_SERIALIZER_H
+#define REG_SERIALIZER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "growattRegisters.h"
+
+/// Output format
+enum RegFormat : uint8_t {
+  FMT_JSON,               // JSON text, NUL-terminated
+  FMT_CBOR                // CBOR (RFC 8949), definite-length maps
+};
+
+/*!
+ * \class RegSerializer
+ *
+ * \brief Bounded single-pass JSON/CBOR writer
+ *
+ * Maps must be opened with the number of key/value pairs they will contain
+ * (required for CBOR definite-length encoding; ignored for JSON).
+ *
+ * Example:
+ *
+ *   RegSerializer out(FMT_JSON, buf, sizeof(buf));
+ *   out.beginMap(2);
+ *   out.key("slave");
+ *   out.value(int32_t(1));
+ *   out.key("input");
+ *   out.registers(inputRegisterMap, NUM_INPUT_REGS_DESC, &data);
+ *   out.endMap();
+ *   size_t len = out.finish();
+ */
+class RegSerializer {
+public:
+    /*!
+     * \brief Constructor
+     *
+     * \param fmt   output format
+     * \param buf   output buffer
+     * \param size  size of output buffer
+     */
+    RegSerializer(RegFormat fmt, uint8_t *buf, size_t size);
+
+    /*!
+     * \brief Open map
+     *
+     * \param n     number of key/value pairs
+     */
+    void beginMap(size_t n);
+
+    /*!
+     * \brief Close map
+     */
+    void endMap(void);
+
+    /*!
+     * \brief Write key
+     *
+     * \param k     key (NUL-terminated)
+     */
+    void key(const char *k);
+
+    /*!
+     * \brief Write integer value
+     */
+    void value(int32_t v);
+
+    /*!
+     * \brief Write unsigned integer value
+     */
+    void value(uint32_t v);
+
+    /*!
+     * \brief Write floating point value
+     *
+     * \param v         value
+     * \param decimals  number of decimals (JSON only)
+     */
+    void value(float v, uint8_t decimals);
+
+    /*!
+     * \brief Write string value
+     *
+     * Non-printable characters are replaced by '?'.
+     *
+     * \param s         string (not necessarily NUL-terminated)
+     * \param maxLen    max. length of string
+     */
+    void value(const char *s, size_t maxLen);
+
+    /*!
+     * \brief Write all fields of a descriptor table as map
+     *
+     * The field names of the descriptor table are used as keys.
+     *
+     * \param table     descriptor table
+     * \param n         number of entries
+     * \param data      data structure (matching the table)
+     */
+    void registers(const RegDesc *table, size_t n, const void *data);
+
+    /*!
+     * \brief Finish output
+     *
+     * \returns length of output (JSON: excluding NUL), 0 on overflow
+     */
+    size_t finish(void);
+
+    /// Output did not fit into buffer
+    bool overflow(void) { return m_overflow; }
+
+private:
+    void put(uint8_t c);
+    void put(const char *s, size_t len);
+    void cborHead(uint8_t major, uint32_t v);
+    void separator(void);
+
+    RegFormat m_fmt;
+    uint8_t  *m_buf;
+    size_t    m_size;
+    size_t    m_pos;
+    bool      m_overflow;
+    bool      m_sep;          //!< JSON: separator required before next key
+};
+
+#endif
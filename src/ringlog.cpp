@@ -0,0 +1,260 @@
+///////////////////////////////////////////////////////////////////////////////
+// ringlog.cpp
+//
+// Persistent ring log in flash for store-and-forward of readings
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Removed fallback to SPIFFS partition
+//          Added hold()/release() for readings of unconfirmed uplinks
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ringlog.h"
+
+#if defined(RINGLOG_EN)
+
+RingLog ringLog;
+
+/// Ring log positions (retained during deep sleep - avoids scanning the log)
+struct RingPos {
+    bool     valid;                 //!< positions are valid
+    uint32_t head;                  //!< next write position
+    uint32_t tail;                  //!< oldest unsent record
+    uint32_t seq;                   //!< next sequence number
+    uint32_t pending;               //!< no. of unsent records
+};
+
+RTC_DATA_ATTR static RingPos ringPos;
+
+/// Readings of unconfirmed uplinks (retained during deep sleep)
+struct RingHold {
+    uint8_t  num;                                   //!< no. of held readings
+    uint32_t time[RINGLOG_HOLD];                    //!< timestamps
+    uint8_t  len[RINGLOG_HOLD];                     //!< data lengths
+    uint8_t  data[RINGLOG_HOLD][RINGLOG_DATA_SIZE]; //!< data
+};
+
+RTC_DATA_ATTR static RingHold ringHold;
+
+#define RECORDS_PER_SECTOR (RINGLOG_SECTOR / sizeof(RingRecord))
+
+bool RingLog::begin(void)
+{
+    m_part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, RINGLOG_LABEL);
+    if (m_part == nullptr) {
+        log_w("No '%s' partition (see partitions.csv) - ring log disabled", RINGLOG_LABEL);
+        return false;
+    }
+
+    uint32_t size = min((uint32_t)m_part->size, (uint32_t)RINGLOG_SIZE);
+    m_num = (size / RINGLOG_SECTOR) * RECORDS_PER_SECTOR;
+    if (m_num < 2 * RECORDS_PER_SECTOR) {
+        log_w("Ring log partition too small");
+        m_part = nullptr;
+        return false;
+    }
+
+    if (!ringPos.valid) {
+        scan();
+    }
+    log_d("Ring log '%s': %u records, %u pending", m_part->label, m_num, ringPos.pending);
+    return true;
+}
+
+bool RingLog::readRecord(uint32_t idx, RingRecord &rec)
+{
+    return esp_partition_read(m_part, idx * sizeof(RingRecord), &rec, sizeof(RingRecord)) == ESP_OK;
+}
+
+bool RingLog::setState(uint32_t idx, uint8_t state)
+{
+    return esp_partition_write(m_part, idx * sizeof(RingRecord), &state, 1) == ESP_OK;
+}
+
+// Restore positions from flash contents (after power-on)
+void RingLog::scan(void)
+{
+    RingRecord rec;
+    uint32_t   maxSeq = 0;
+    uint32_t   minSeq = UINT32_MAX;
+    bool       used   = false;
+
+    ringPos.head    = 0;
+    ringPos.tail    = 0;
+    ringPos.pending = 0;
+
+    for (uint32_t idx = 0; idx < m_num; idx++) {
+        if (!readRecord(idx, rec) || (rec.seq == UINT32_MAX))
+            continue;
+
+        // incomplete writes also occupy their position
+        if (!used || (rec.seq >= maxSeq)) {
+            maxSeq       = rec.seq;
+            ringPos.head = next(idx);
+            used         = true;
+        }
+        if (rec.state == RINGLOG_COMMITTED) {
+            ringPos.pending++;
+            if (rec.seq < minSeq) {
+                minSeq       = rec.seq;
+                ringPos.tail = idx;
+            }
+        }
+    }
+    ringPos.seq = used ? maxSeq + 1 : 0;
+    if (ringPos.pending == 0)
+        ringPos.tail = ringPos.head;
+    ringPos.valid = true;
+}
+
+bool RingLog::write(uint32_t time, const uint8_t *data, uint8_t len)
+{
+    if ((m_part == nullptr) || (len > RINGLOG_DATA_SIZE))
+        return false;
+
+    uint32_t idx = ringPos.head;
+
+    if ((idx % RECORDS_PER_SECTOR) == 0) {
+        // Entering sector - discard unsent records in it (log full)
+        RingRecord rec;
+        for (uint32_t i = idx; i < idx + RECORDS_PER_SECTOR; i++) {
+            if (readRecord(i, rec) && (rec.state == RINGLOG_COMMITTED) && (ringPos.pending > 0))
+                ringPos.pending--;
+        }
+        if ((ringPos.tail >= idx) && (ringPos.tail < idx + RECORDS_PER_SECTOR)) {
+            ringPos.tail = (idx + RECORDS_PER_SECTOR) % m_num;
+        }
+        if (esp_partition_erase_range(m_part, idx * sizeof(RingRecord), RINGLOG_SECTOR) != ESP_OK) {
+            log_e("Ring log erase failed");
+            return false;
+        }
+    }
+
+    RingRecord rec;
+    memset(&rec, 0xFF, sizeof(rec));
+    rec.len  = len;
+    rec.seq  = ringPos.seq++;
+    rec.time = time;
+    memcpy(rec.data, data, len);
+
+    ringPos.head = next(idx);
+
+    // write data first, then commit by clearing state bit
+    if ((esp_partition_write(m_part, idx * sizeof(RingRecord), &rec, sizeof(rec)) != ESP_OK) ||
+        !setState(idx, RINGLOG_COMMITTED)) {
+        log_e("Ring log write failed");
+        return false;
+    }
+    if (ringPos.pending == 0)
+        ringPos.tail = idx;
+    ringPos.pending++;
+    return true;
+}
+
+uint32_t RingLog::pending(void)
+{
+    return (m_part == nullptr) ? 0 : ringPos.pending;
+}
+
+uint8_t RingLog::read(RingRecord *recs, uint8_t max)
+{
+    uint32_t idx = ringPos.tail;
+
+    m_readNum = 0;
+    if ((m_part == nullptr) || (ringPos.pending == 0))
+        return 0;
+
+    while ((m_readNum < max) && (idx != ringPos.head)) {
+        if (readRecord(idx, recs[m_readNum]) && (recs[m_readNum].state == RINGLOG_COMMITTED))
+            m_readNum++;
+        idx = next(idx);
+    }
+    m_readEnd = idx;
+    return m_readNum;
+}
+
+void RingLog::markSent(void)
+{
+    RingRecord rec;
+
+    if ((m_part == nullptr) || (m_readNum == 0))
+        return;
+
+    for (uint32_t idx = ringPos.tail; idx != m_readEnd; idx = next(idx)) {
+        if (readRecord(idx, rec) && (rec.state == RINGLOG_COMMITTED)) {
+            setState(idx, RINGLOG_SENT);
+            if (ringPos.pending > 0)
+                ringPos.pending--;
+        }
+    }
+    ringPos.tail = (ringPos.pending == 0) ? ringPos.head : m_readEnd;
+    m_readNum    = 0;
+}
+
+void RingLog::hold(uint32_t time, const uint8_t *data, uint8_t len)
+{
+    if ((m_part == nullptr) || (len == 0) || (len > RINGLOG_DATA_SIZE))
+        return;
+
+    if (ringHold.num >= RINGLOG_HOLD) {
+        // no confirmed uplink for too long - log oldest reading
+        write(ringHold.time[0], ringHold.data[0], ringHold.len[0]);
+        ringHold.num--;
+        memmove(&ringHold.time[0], &ringHold.time[1], ringHold.num * sizeof(ringHold.time[0]));
+        memmove(&ringHold.len[0], &ringHold.len[1], ringHold.num * sizeof(ringHold.len[0]));
+        memmove(&ringHold.data[0], &ringHold.data[1], ringHold.num * sizeof(ringHold.data[0]));
+    }
+    ringHold.time[ringHold.num] = time;
+    ringHold.len[ringHold.num]  = len;
+    memcpy(ringHold.data[ringHold.num], data, len);
+    ringHold.num++;
+}
+
+void RingLog::release(bool acked)
+{
+    if (!acked) {
+        for (uint8_t i = 0; i < ringHold.num; i++)
+            write(ringHold.time[i], ringHold.data[i], ringHold.len[i]);
+        if (ringHold.num)
+            log_d("Ring log: %u readings of unconfirmed uplinks logged", ringHold.num);
+    }
+    ringHold.num = 0;
+}
+
+uint8_t RingLog::held(void)
+{
+    return ringHold.num;
+}
+
+#endif
@@ -0,0 +1,183 @@
+///////////////////////////////////////////////////////////////////////////////
+// ringlog.h
+//
+// Persistent ring log in flash for store-and-forward of readings
+//
+// Readings which could not be sent (join failed or uplink not acknowledged)
+// are written as timestamped records into a dedicated flash partition and
+// sent later in batches (backfill) when the link is available again.
+//
+// Success of an unconfirmed uplink only means 'transmitted', so its
+// reading is held in RTC RAM (hold()) until the next confirmed uplink:
+// if that is acknowledged, the held readings are dropped; otherwise they
+// are written to the log (release()). At most RINGLOG_HOLD readings are
+// held - the sketch forces a confirmed uplink when this limit is reached.
+//
+// The data partition with label "ringlog" is required - it is provided by
+// partitions.csv in the sketch directory (4 MB flash, 64 kB ring log):
+//   ringlog,  data, 0x40,     0x3E0000, 0x10000,
+// Without this partition, the ring log is disabled; other partitions
+// (e.g. SPIFFS) are never used. Only RINGLOG_SIZE bytes of the partition
+// are used.
+//
+// Flash bits can only be cleared without erasing, so the state of a
+// record is changed by clearing bits:
+//   0xFF - empty       (erased)
+//   0xFE - committed   (data valid, not sent)
+//   0xFC - sent
+// Records are written sequentially; a sector is erased when the write
+// position enters it, i.e. all sectors are erased equally often and the
+// oldest records are overwritten when the log is full.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Dedicated partition required (partitions.csv), no SPIFFS fallback
+//          Added hold()/release() for readings of unconfirmed uplinks
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef RINGLOG_H
+#define RINGLOG_H
+
+#include "Arduino.h"
+#include "settings.h"
+#include "esp_partition.h"
+
+#define RINGLOG_LABEL       "ringlog"   // partition label
+#define RINGLOG_SECTOR      4096        // flash sector size
+#define RINGLOG_DATA_SIZE   20          // max. data size per record
+
+#define RINGLOG_EMPTY       0xFF        // record state: empty
+#define RINGLOG_COMMITTED   0xFE        // record state: committed
+#define RINGLOG_SENT        0xFC        // record state: sent
+
+/// Ring log record (flash layout)
+struct RingRecord {
+    uint8_t  state;                     //!< record state
+    uint8_t  len;                       //!< data length
+    uint16_t reserved;                  //!< reserved (0xFFFF)
+    uint32_t seq;                       //!< sequence number
+    uint32_t time;                      //!< timestamp (UNIX time)
+    uint8_t  data[RINGLOG_DATA_SIZE];   //!< data
+};
+
+static_assert(RINGLOG_SECTOR % sizeof(RingRecord) == 0, "RingRecord size must divide sector size");
+
+/*!
+ * \class RingLog
+ *
+ * \brief Persistent ring log in flash
+ */
+class RingLog {
+public:
+    RingLog() {};
+
+    /*!
+     * \brief Find partition and restore read/write positions
+     *
+     * \returns true if a partition is available
+     */
+    bool begin(void);
+
+    /*!
+     * \brief Write record
+     *
+     * \param time     timestamp
+     * \param data     data
+     * \param len      data length (max. RINGLOG_DATA_SIZE)
+     *
+     * \returns true on success
+     */
+    bool write(uint32_t time, const uint8_t *data, uint8_t len);
+
+    /*!
+     * \brief Read oldest unsent records
+     *
+     * The records are marked as sent by markSent().
+     *
+     * \param recs     record buffer
+     * \param max      max. no. of records
+     *
+     * \returns no. of records read
+     */
+    uint8_t read(RingRecord *recs, uint8_t max);
+
+    /*!
+     * \brief Mark records returned by the last read() as sent
+     */
+    void markSent(void);
+
+    /// No. of unsent records
+    uint32_t pending(void);
+
+    /*!
+     * \brief Hold reading of unconfirmed uplink until the next confirmed uplink
+     *
+     * If RINGLOG_HOLD readings are already held, the oldest one is written
+     * to the log.
+     *
+     * \param time     timestamp
+     * \param data     data
+     * \param len      data length (max. RINGLOG_DATA_SIZE)
+     */
+    void hold(uint32_t time, const uint8_t *data, uint8_t len);
+
+    /*!
+     * \brief Release held readings after a confirmed uplink
+     *
+     * \param acked    true:  uplink acknowledged - readings are dropped
+     *                  false: readings are written to the log
+     */
+    void release(bool acked);
+
+    /// No. of held readings
+    uint8_t held(void);
+
+private:
+    uint32_t next(uint32_t idx) {
+        return (idx + 1) % m_num;
+    }
+    bool readRecord(uint32_t idx, RingRecord &rec);
+    bool setState(uint32_t idx, uint8_t state);
+    void scan(void);
+
+    const esp_partition_t *m_part = nullptr;    //!< flash partition
+    uint32_t m_num;                             //!< no. of records in log
+    uint32_t m_readEnd;                         //!< position after last record read
+    uint8_t  m_readNum = 0;                     //!< no. of records returned by last read()
+};
+
+/// Ring log
+extern RingLog ringLog;
+
+#endif
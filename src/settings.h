@@ -43,6 +43,30 @@
 // 20230421 Added pin config for 
 //          Adafruit Feather ESP32 + LoRa Radio Featherwing
 // 20231009 Renamed FIREBEETLE_COVER_LORA in FIREBEETLE_ESP32_COVER_LORA
+// 20261016 Added MODBUS_MAX_GAP and MODBUS_REQ_DELAY
+//          Added ACQ_TASK
+//          Added PAYLOAD_VERSION and PAYLOAD_DELTA
+//          Added PAYLOAD_HEADER_V3
+//          Added SIM_MODBUS
+//          Added ENABLE_TIMING
+//          Added MODBUS_NATIVE
+//          Added MODBUS_SLAVES
+//          Added RINGLOG_EN
+//          Added PAYLOAD_AGG
+//          Added RBE_EN
+//          Added uplink policy defaults (POLICY_*)
+//          Added SETTINGS_REFRESH/SETTINGS_RETRY
+//          Added POWER_LIMIT_INTERVAL/POWER_LIMIT_RETRIES
+//          Added ENABLE_CBOR/JSON_BUF_SIZE
+//          Moved pin definitions to board profiles (boards.h)
+//          Added MODBUS_IF
+//          Added MODBUS_BACKOFF_MIN/MODBUS_BACKOFF_MAX/MODBUS_REINIT_AFTER
+//          Added uplink scheduler defaults (SCHED_*)
+//          Added fault/warning event queue (EVENT_*, PAYLOAD_PORT_EVENTS)
+//          Added grid disturbance capture (CAPTURE_*, PAYLOAD_PORT_CAPTURE)
+//          Added RINGLOG_HOLD
+//          Default MODBUS_IF is MODBUS_IF_RS485
+//          Added CAPTURE_FREQ_HYST/CAPTURE_VOLT_HYST/CAPTURE_REARM_HOLDOFF
 //
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -55,67 +79,124 @@
 
 //#define useModulPower   1
 
-//#define ENABLE_JSON
+//#define ENABLE_JSON               // Write register data as JSON lines to Serial (RS485 interface only)
+//#define ENABLE_CBOR               // Write register data as CBOR sequence instead of JSON
+#define JSON_BUF_SIZE   1024      // Serializer buffer size in bytes
 //#define GEN_PAYLOAD               // Generate payload for debugging (do not read Modbus)
+//#define SIM_MODBUS                // Simulate Growatt inverter for debugging (see growattSim.h)
+#define SIM_MODBUS_LATENCY     20   // simulated response latency in ms
+#define SIM_MODBUS_CRC_ERR     0    // simulated CRC error rate in per mille
+#define SIM_MODBUS_TIMEOUT_ERR 0    // simulated timeout rate in per mille
+#define SIM_MODBUS_SLAVES      4    // simulated inverters respond to slave IDs 1...n
+//#define ENABLE_TIMING             // Measure execution time of acquisition and uplink stages
+#define TIMING_REPORT   10        // log timing summary every <n> uplinks
 //#define SLAVE_ID        1         // Default slave ID of Growatt
+#define MODBUS_SLAVES   {1}       // Slave IDs of all inverters on the RS485 bus, e.g. {1, 2, 3}
+#define MAX_SLAVES      4         // max. no. of inverters
 //#define SERIAL_RATE     115200    // Serial speed for status info
 //#define MODBUS_RATE     9600      // Modbus speed of Growatt, do not change
 
 #define UPDATE_MODBUS   2         // Modbus device is read every <n> seconds
 #define MODBUS_RETRIES  5         // no. of modbus retries
+#define MODBUS_BACKOFF_MIN  4     // inverter not responding: skip acquisitions for <n> seconds (doubled after each failure)
+#define MODBUS_BACKOFF_MAX  300   // max. backoff period in seconds
+#define MODBUS_REINIT_AFTER 3     // re-initialize Modbus interface after <n> consecutive failed acquisitions
+#define MODBUS_MAX_GAP  16        // max. no. of unused registers read to save a separate request
+#define MODBUS_REQ_DELAY 100      // delay between consecutive Modbus requests in ms
+#define SETTINGS_REFRESH 86400    // cached inverter settings (holding registers) are refreshed every <n> seconds
+#define SETTINGS_RETRY   600      // retry interval in seconds if reading inverter settings failed
+#define POWER_LIMIT_INTERVAL 30   // min. interval between power limit write attempts in seconds
+#define POWER_LIMIT_RETRIES  3    // max. no. of power limit write attempts
 
-#define STATUS_LED    LED_BUILTIN     // Status LED
-
-#if defined(ARDUINO_TTGO_LoRa32_v21new)
-    // https://github.com/espressif/arduino-esp32/blob/master/variants/ttgo-lora32-v21new/pins_arduino.h
-    #define INTERFACE_SEL   13        // Modbus interface select (0: USB / 1: RS485)
-    #define MAX485_DE       14        // D1, DE pin on the TTL to RS485 converter
-    #define MAX485_RE_NEG   2         // D2, RE pin on the TTL to RS485 converter
-    #define MAX485_RX       15        // D5, RO pin on the TTL to RS485 converter
-    #define MAX485_TX       12        // D6, DI pin on the TTL to RS485 converter
-    #define DEBUG_TX        00        // Serial port output to   USB converter
-    #define DEBUG_RX        04        // Serial port input  from USB converter (n.c.)
-
-#elif defined(FIREBEETLE_ESP32_COVER_LORA)
-    // https://wiki.dfrobot.com/FireBeetle_ESP32_IOT_Microcontroller(V3.0)__Supports_Wi-Fi_&_Bluetooth__SKU__DFR0478
-    // https://wiki.dfrobot.com/FireBeetle_Covers_LoRa_Radio_868MHz_SKU_TEL0125
-    #define INTERFACE_SEL   17        // Modbus interface select (0: USB / 1: RS485)
-    #define MAX485_DE       10        // D6, DE pin on the TTL to RS485 converter
-    #define MAX485_RE_NEG   13        // D7, RE pin on the TTL to RS485 converter
-    #define MAX485_RX       5         // D8, RO pin on the TTL to RS485 converter
-    #define MAX485_TX       2         // D9, DI pin on the TTL to RS485 converter
-    #define DEBUG_TX        4         // Serial port output to   USB converter
-    #define DEBUG_RX        16        // Serial port input  from USB converter (n.c.)
-        
-#elif defined(LORAWAN_NODE)
-    // LoRaWAN_Node board
-    // https://github.com/matthias-bs/LoRaWAN_Node
-    #define INTERFACE_SEL   13        // Modbus interface select (0: USB / 1: RS485)
-    #define MAX485_DE       10        // D1, DE pin on the TTL to RS485 converter
-    #define MAX485_RE_NEG   2         // D2, RE pin on the TTL to RS485 converter
-    #define MAX485_RX       27        // D5, RO pin on the TTL to RS485 converter
-    #define MAX485_TX       9         // D6, DI pin on the TTL to RS485 converter
-    #define DEBUG_TX        5         // Serial port output to   USB converter (optional)
-    #define DEBUG_RX        26        // Serial port input  from USB converter (n.c.)
-
-#elif defined(ARDUINO_FEATHER_ESP32)
-    // https://github.com/espressif/arduino-esp32/blob/master/variants/feather_esp32/pins_arduino.h
-    #define INTERFACE_SEL   13        // Modbus interface select (0: USB / 1: RS485)
-    #define MAX485_DE       4         // D1, DE pin on the TTL to RS485 converter
-    #define MAX485_RE_NEG   15        // D2, RE pin on the TTL to RS485 converter
-    #define MAX485_RX       22        // D5, RO pin on the TTL to RS485 converter
-    #define MAX485_TX       23        // D6, DI pin on the TTL to RS485 converter
-    #define DEBUG_TX        12        // Serial port output to   USB converter (optional)
-    #define DEBUG_RX        21        // Serial port input  from USB converter (n.c.)
-
-#else
-    // for generic CI target ESP32:ESP32:ESP32
-    #define INTERFACE_SEL   13        // Modbus interface select (0: USB / 1: RS485)
-    #define MAX485_DE       10        // D1, DE pin on the TTL to RS485 converter
-    #define MAX485_RE_NEG   2         // D2, RE pin on the TTL to RS485 converter
-    #define MAX485_RX       27        // D5, RO pin on the TTL to RS485 converter
-    #define MAX485_TX       9         // D6, DI pin on the TTL to RS485 converter
-    #define DEBUG_TX        5         // Serial port output to   USB converter (optional)
-    #define DEBUG_RX        26        // Serial port input  from USB converter (n.c.)
+// Modbus interface
+#define MODBUS_IF_AUTO  0         // selected by interface select pin (read once after reset/wakeup; runtime branches)
+#define MODBUS_IF_RS485 1         // RS485 only (Serial2 with RS485 transceiver)
+#define MODBUS_IF_USB   2         // USB only (Serial)
+#define MODBUS_IF       MODBUS_IF_RS485
+//#define MODBUS_NATIVE             // Use native ESP32 UART Modbus transport (RS485 half-duplex mode, see modbusRtu.h)
 
+// Read Modbus data in a separate task on the other core (dual-core ESP32 only);
+// uplinks are encoded from the latest snapshot without waiting for Modbus
+#if !defined(CONFIG_FREERTOS_UNICORE)
+    #define ACQ_TASK
 #endif
+
+// Uplink payload format
+// 1: legacy - values encoded as raw float
+// 2: compact - values encoded as fixed-point integers
+#define PAYLOAD_VERSION   2
+
+// Compact payload format: encode totals as difference to last acknowledged uplink
+// with absolute values (key frame)
+// (reconstruction of absolute values requires state in the network server integration)
+//#define PAYLOAD_DELTA
+
+// Compact payload format: add min/max/mean and energy since last uplink
+// (sampled every UPDATE_MODBUS seconds) to port 1 data (see aggregator.h)
+//#define PAYLOAD_AGG
+
+#define PAYLOAD_KEYFRAME  10            // send absolute totals at least every <n> frames
+#define PAYLOAD_HEADER_V2 0x20          // header byte of compact payload format
+#define PAYLOAD_HEADER_V3 0x30          // header byte of grouped payload format
+#define PAYLOAD_PORT_SLAVES 8           // uplink port of multi-inverter payload (more than one slave)
+#define PAYLOAD_FLAG_DELTA 0x01         // header flag: totals are delta encoded
+
+// Store readings which could not be sent in a flash ring log and send them
+// later in batches (requires PAYLOAD_VERSION 2; see ringlog.h)
+//#define RINGLOG_EN
+#define RINGLOG_SIZE      0x10000       // max. ring log size in bytes (multiple of 4096)
+#define RINGLOG_BATCH     12            // max. no. of records per backfill uplink
+#define RINGLOG_HOLD      8             // max. no. of readings of unconfirmed uplinks held until a confirmed uplink
+#define BACKFILL_INTERVAL 120           // min. interval between backfill uplinks in seconds
+#define PAYLOAD_PORT_BACKFILL 9         // uplink port of backfill payload
+
+// Report by exception: skip uplinks of data groups which have not changed
+// by more than their deadband since the last successful uplink (see rbe.h)
+//#define RBE_EN
+#define RBE_HEARTBEAT     10            // send unchanged data at least after <n> suppressed uplinks
+#define RBE_DEADBAND      {20, 20, 10, 1, 50, 5, 20, 20, 20, 1} // default deadbands (see rbe.h)
+
+// Uplink policy: data is sent unconfirmed except every <n>th uplink (link check);
+// all uplinks are confirmed while ACK rate or link margin are low (see uplinkPolicy.h)
+#define POLICY_CONFIRM_EVERY  8         // default confirmed uplink interval (0: never, 1: always)
+#define POLICY_ACK_RATE_MIN   75        // default min. ACK rate of last 8 confirmed uplinks in %
+#define POLICY_MARGIN_MIN     3         // default min. link margin of ACK in dB
+#define POLICY_RECOVER        3         // no. of good ACKs required to end escalation
+
+// Uplink scheduler: uplink interval is stretched while the inverter is offline,
+// waiting or the local time is in the night window; fault/derating
+// changes trigger an immediate uplink (see uplinkScheduler.h)
+#define SCHED_IDLE_INTERVAL   60        // default uplink interval while idle in minutes (0: disabled)
+#define SCHED_MIN_POWER       10        // default min. output power in production in W
+#define SCHED_NIGHT_START     22        // default start of night window (local time, hour)
+#define SCHED_NIGHT_END       4         // default end of night window (local time, hour)
+#define SCHED_BURST_HOLDOFF   60        // min. interval between immediate uplinks in seconds
+#define SCHED_POLL_INTERVAL   30        // inverter state polling interval between uplinks in seconds
+
+// Fault/warning events: changes of faultbitcode/warningbitcode are sent
+// ahead of the periodic uplinks (see faultEvents.h)
+#define EVENT_QUEUE_SIZE      16        // max. no. of queued events
+#define EVENT_INTERVAL        10        // min. interval between event uplinks in seconds
+#define EVENT_RETRY           60        // retry interval after failed event uplink in seconds
+#define PAYLOAD_PORT_EVENTS   10        // uplink port of event payload
+
+// Grid disturbance capture: gridfrequency, gridvoltage and outputpower are polled
+// every CAPTURE_PERIOD ms; a window around a threshold crossing is sent in chunks
+// (see gridCapture.h; not available with SLEEP_EN)
+//#define CAPTURE_EN
+#define CAPTURE_PERIOD        200       // sample period in ms
+#define CAPTURE_PRE           50        // no. of samples before trigger
+#define CAPTURE_POST          150       // no. of samples after trigger
+#define CAPTURE_FREQ_NOM      50.0f     // nominal grid frequency in Hz
+#define CAPTURE_FREQ_DEV      0.2f      // trigger: max. frequency deviation in Hz
+#define CAPTURE_VOLT_MIN      207.0f    // trigger: min. grid voltage in V
+#define CAPTURE_VOLT_MAX      253.0f    // trigger: max. grid voltage in V
+#define CAPTURE_FREQ_HYST     0.05f     // re-arm: frequency hysteresis in Hz
+#define CAPTURE_VOLT_HYST     2.0f      // re-arm: voltage hysteresis in V
+#define CAPTURE_REARM_HOLDOFF 300       // re-arm: min. time with normal values in seconds
+#define CAPTURE_UPLINK_INTERVAL 60      // min. interval between capture uplinks in seconds
+#define PAYLOAD_PORT_CAPTURE  11        // uplink port of capture payload
+
+#define STATUS_LED    LED_BUILTIN     // Status LED
+
+// Board profiles (pin assignments): see boards.h
@@ -0,0 +1,203 @@
+///////////////////////////////////////////////////////////////////////////////
+// settingsCache.cpp
+//
+// Cache of inverter settings (holding registers)
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Retry interval applies if no valid data is cached
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <Preferences.h>
+#include "settingsCache.h"
+#include "growattInterface.h"
+
+SettingsCache settingsCache;
+
+/// Cached settings - in RTC RAM to survive deep sleep
+struct SettingsState {
+    bool     valid;                         //!< data is valid
+    bool     restored;                      //!< data restored from flash, age unknown
+    time_t   time;                          //!< time of last refresh
+    time_t   next;                          //!< time of next refresh
+    uint8_t  data[SETTINGS_DATA_SIZE];      //!< encoded holding registers
+};
+
+RTC_DATA_ATTR static SettingsState settingsState;
+
+// Fixed-point value, saturated to uint16
+static uint16_t fixp16(float value, float scale)
+{
+    long v = lroundf(value * scale);
+    return (v < 0) ? 0 : (v > UINT16_MAX) ? UINT16_MAX : v;
+}
+
+/*
+ * Inverter settings (FPort 5)
+ *
+ * byte 0: age of data [h] (0xFE: unknown, 0xFF: no data - no further bytes)
+ *
+ * uint8   enable
+ * uint8   safetyfuncen
+ * uint8   maxoutputactivepp        [%] (255: not limited)
+ * uint8   maxoutputreactivepp      [%] (255: not limited)
+ * uint16  maxpower                 [1 W]
+ * uint16  voltnormal               [0.1 V]
+ * uint16  startvoltage             [0.1 V]
+ * uint16  gridvoltlowlimit         [0.1 V]
+ * uint16  gridvolthighlimit        [0.1 V]
+ * uint16  gridfreqlowlimit         [0.01 Hz]
+ * uint16  gridfreqhighlimit        [0.01 Hz]
+ * uint16  gridvoltlowconnlimit     [0.1 V]
+ * uint16  gridvolthighconnlimit    [0.1 V]
+ * uint16  gridfreqlowconnlimit     [0.01 Hz]
+ * uint16  gridfreqhighconnlimit    [0.01 Hz]
+ * uint16  modul
+ * char[6] firmware
+ * char[6] controlfirmware
+ * char[10] serial
+ */
+static void encode_settings(const modbus_holding_registers &s, uint8_t *buf)
+{
+    LoraEncoder encoder(buf);
+
+    encoder.writeUint8(s.enable);
+    encoder.writeUint8(s.safetyfuncen);
+    encoder.writeUint8(s.maxoutputactivepp);
+    encoder.writeUint8(s.maxoutputreactivepp);
+    encoder.writeUint16(fixp16(s.maxpower, 1));
+    encoder.writeUint16(fixp16(s.voltnormal, 10));
+    encoder.writeUint16(fixp16(s.startvoltage, 10));
+    encoder.writeUint16(fixp16(s.gridvoltlowlimit, 10));
+    encoder.writeUint16(fixp16(s.gridvolthighlimit, 10));
+    encoder.writeUint16(fixp16(s.gridfreqlowlimit, 100));
+    encoder.writeUint16(fixp16(s.gridfreqhighlimit, 100));
+    encoder.writeUint16(fixp16(s.gridvoltlowconnlimit, 10));
+    encoder.writeUint16(fixp16(s.gridvolthighconnlimit, 10));
+    encoder.writeUint16(fixp16(s.gridfreqlowconnlimit, 100));
+    encoder.writeUint16(fixp16(s.gridfreqhighconnlimit, 100));
+    encoder.writeUint16(s.modul);
+    for (size_t i = 0; i < sizeof(s.firmware); i++)
+        encoder.writeUint8(s.firmware[i]);
+    for (size_t i = 0; i < sizeof(s.controlfirmware); i++)
+        encoder.writeUint8(s.controlfirmware[i]);
+    for (size_t i = 0; i < sizeof(s.serial); i++)
+        encoder.writeUint8(s.serial[i]);
+}
+
+void SettingsCache::begin(void)
+{
+    if (settingsState.valid)
+        return;
+
+    Preferences prefs;
+    prefs.begin("GROWATT2LORAWAN", true);
+    if (prefs.getBytes("settings", settingsState.data, SETTINGS_DATA_SIZE) == SETTINGS_DATA_SIZE) {
+        settingsState.valid    = true;
+        settingsState.restored = true;
+        settingsState.next     = 0;
+        log_d("Inverter settings restored from flash");
+    }
+    prefs.end();
+}
+
+// next is 0 after power-on, i.e. the first refresh is due immediately;
+// after a failed read, the retry interval applies even without valid data
+bool SettingsCache::isDue(void)
+{
+    return time(nullptr) >= settingsState.next;
+}
+
+void SettingsCache::invalidate(void)
+{
+    settingsState.next = 0;
+}
+
+void SettingsCache::update(uint8_t result, const modbus_holding_registers &data)
+{
+    time_t now = time(nullptr);
+
+    if (result != growattIF::Success) {
+        // keep cached data, try again later
+        log_w("Reading inverter settings failed (0x%02X)", result);
+        settingsState.next = now + SETTINGS_RETRY;
+        return;
+    }
+
+    uint8_t buf[SETTINGS_DATA_SIZE];
+    encode_settings(data, buf);
+
+    bool changed = !settingsState.valid || memcmp(buf, settingsState.data, SETTINGS_DATA_SIZE);
+
+    portENTER_CRITICAL(&m_mux);
+    memcpy(settingsState.data, buf, SETTINGS_DATA_SIZE);
+    settingsState.valid    = true;
+    settingsState.restored = false;
+    settingsState.time     = now;
+    settingsState.next     = now + SETTINGS_REFRESH;
+    portEXIT_CRITICAL(&m_mux);
+
+    if (changed) {
+        // save to flash only if settings have changed
+        Preferences prefs;
+        prefs.begin("GROWATT2LORAWAN", false);
+        prefs.putBytes("settings", buf, SETTINGS_DATA_SIZE);
+        prefs.end();
+        log_d("Inverter settings changed - saved to flash");
+    }
+}
+
+void SettingsCache::encode(LoraEncoder &encoder)
+{
+    uint8_t buf[SETTINGS_DATA_SIZE];
+    uint8_t age;
+
+    portENTER_CRITICAL(&m_mux);
+    memcpy(buf, settingsState.data, SETTINGS_DATA_SIZE);
+    if (!settingsState.valid) {
+        age = SETTINGS_NO_DATA;
+    } else if (settingsState.restored) {
+        age = SETTINGS_AGE_UNKNOWN;
+    } else {
+        time_t hours = (time(nullptr) - settingsState.time) / 3600;
+        age = (hours < SETTINGS_AGE_UNKNOWN) ? hours : SETTINGS_AGE_UNKNOWN - 1;
+    }
+    portEXIT_CRITICAL(&m_mux);
+
+    encoder.writeUint8(age);
+    if (age == SETTINGS_NO_DATA)
+        return;
+    for (uint8_t i = 0; i < SETTINGS_DATA_SIZE; i++)
+        encoder.writeUint8(buf[i]);
+}
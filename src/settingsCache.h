@@ -0,0 +1,113 @@
+///////////////////////////////////////////////////////////////////////////////
+// settingsCache.h
+//
+// Cache of inverter settings (holding registers)
+//
+// The holding registers of the first inverter are read in the background
+// after an input register acquisition if the cached data is older than
+// SETTINGS_REFRESH seconds. The compact encoding (FPort 5) is kept in
+// RTC RAM and in flash, so CMD_GET_INVERTER_SETTINGS is answered
+// immediately without Modbus access.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Retry interval applies if no valid data is cached
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef SETTINGS_CACHE_H
+#define SETTINGS_CACHE_H
+
+#include "Arduino.h"
+#include <LoraMessage.h>
+#include "settings.h"
+#include "growattRegisters.h"
+
+#define SETTINGS_DATA_SIZE  50                          //!< size of encoded holding registers
+#define SETTINGS_SIZE       (1 + SETTINGS_DATA_SIZE)    //!< size of FPort 5 payload
+
+#define SETTINGS_AGE_UNKNOWN    0xFE    //!< age: restored from flash after power-on
+#define SETTINGS_NO_DATA        0xFF    //!< age: no data available
+
+/*!
+ * \class SettingsCache
+ *
+ * \brief Cache of encoded inverter settings
+ */
+class SettingsCache {
+public:
+    SettingsCache() {};
+
+    /*!
+     * \brief Restore cached settings from flash (after power-on)
+     */
+    void begin(void);
+
+    /*!
+     * \brief Check if refresh is due
+     *
+     * Due after power-on, invalidate() or expiry of SETTINGS_REFRESH
+     * (SETTINGS_RETRY after a failed read, even if no data is cached).
+     *
+     * \returns true if the holding registers shall be read
+     */
+    bool isDue(void);
+
+    /*!
+     * \brief Update cache after reading the holding registers
+     *
+     * \param result   Modbus result
+     * \param data     holding register data (valid if result is Success)
+     */
+    void update(uint8_t result, const modbus_holding_registers &data);
+
+    /*!
+     * \brief Force refresh with next acquisition
+     */
+    void invalidate(void);
+
+    /*!
+     * \brief Encode cached settings (FPort 5)
+     *
+     * \param encoder  LoraEncoder object
+     */
+    void encode(LoraEncoder &encoder);
+
+private:
+    portMUX_TYPE m_mux = portMUX_INITIALIZER_UNLOCKED;
+};
+
+/// Inverter settings cache
+extern SettingsCache settingsCache;
+
+#endif
@@ -0,0 +1,126 @@
+///////////////////////////////////////////////////////////////////////////////
+// snapshot.h
+//
+// Lock-free double buffer for Modbus register snapshots
+//
+// The writer (data acquisition) always fills the buffer which is currently
+// not published and then publishes it. Each buffer is protected by a
+// sequence counter (odd while being written), so a reader retries only if
+// the writer has overwritten the buffer during the copy.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdint.h>
+#include <atomic>
+#include "growattRegisters.h"
+
+/// Modbus register snapshot
+struct Snapshot {
+    modbus_input_registers data;    //!< last valid input register data
+    uint8_t  result;                //!< result of last acquisition (growattIF::Success or Modbus error code)
+    uint32_t timestamp;             //!< time of last valid data [ms]
+};
+
+/*!
+ * \class SnapshotBuffer
+ *
+ * \brief Single writer / multiple reader double buffer
+ */
+class SnapshotBuffer {
+public:
+    SnapshotBuffer() {};
+
+    /*!
+     * \brief Publish snapshot (writer only)
+     *
+     * \param snap snapshot
+     */
+    void publish(const Snapshot &snap) {
+        uint8_t  idx = m_latest.load(std::memory_order_relaxed) ^ 1;
+        Slot    &slot = m_slot[idx];
+        uint32_t seq  = slot.seq.load(std::memory_order_relaxed);
+
+        slot.seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.snap = snap;
+        slot.seq.store(seq + 2, std::memory_order_release);
+        m_latest.store(idx, std::memory_order_release);
+        m_valid.store(true, std::memory_order_release);
+    }
+
+    /*!
+     * \brief Copy latest snapshot
+     *
+     * \param snap snapshot
+     *
+     * \returns false if no snapshot has been published yet
+     */
+    bool read(Snapshot &snap) {
+        if (!m_valid.load(std::memory_order_acquire))
+            return false;
+
+        uint32_t seq1;
+        uint32_t seq2;
+        do {
+            const Slot &slot = m_slot[m_latest.load(std::memory_order_acquire)];
+            seq1 = slot.seq.load(std::memory_order_acquire);
+            snap = slot.snap;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            seq2 = slot.seq.load(std::memory_order_relaxed);
+        } while ((seq1 & 1) || (seq1 != seq2));
+        return true;
+    }
+
+    /// Snapshot has been published at least once
+    bool isValid(void) {
+        return m_valid.load(std::memory_order_acquire);
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> seq{0};   //!< sequence counter, odd while writing
+        Snapshot snap;                  //!< snapshot data
+    };
+
+    Slot                 m_slot[2];
+    std::atomic<uint8_t> m_latest{0};   //!< index of latest published slot
+    std::atomic<bool>    m_valid{false};
+};
+
+#endif
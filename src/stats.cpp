@@ -0,0 +1,113 @@
+///////////////////////////////////////////////////////////////////////////////
+// stats.cpp
+//
+// Runtime statistics (kept in RTC RAM across deep sleep)
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Moved rtStats from growatt2lorawan.ino (host build)
+//          Counters changed to uint32, encoded as uint24 (wrap around)
+//          stats_inc()/stats_add() protected by critical section
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "stats.h"
+
+RTC_DATA_ATTR RuntimeStats rtStats;
+
+// Statistics are updated from the acquisition task and from loop()
+static portMUX_TYPE statsMux = portMUX_INITIALIZER_UNLOCKED;
+
+void stats_inc(uint32_t &counter)
+{
+    portENTER_CRITICAL(&statsMux);
+    counter++;
+    portEXIT_CRITICAL(&statsMux);
+}
+
+void stats_add(StatHist &h, uint32_t value)
+{
+    uint16_t v = (value > UINT16_MAX) ? UINT16_MAX : value;
+
+    portENTER_CRITICAL(&statsMux);
+    if ((h.count == 0) || (v < h.min))
+        h.min = v;
+    if (v > h.max)
+        h.max = v;
+    if (h.count == UINT16_MAX) {
+        // keep mean, halve weight of history
+        h.sum   /= 2;
+        h.count /= 2;
+    }
+    h.sum += v;
+    h.count++;
+    portEXIT_CRITICAL(&statsMux);
+}
+
+// Encode min/max/mean
+static void encode_hist(const StatHist &h, LoraEncoder &encoder)
+{
+    encoder.writeUint16(h.min);
+    encoder.writeUint16(h.max);
+    encoder.writeUint16(h.count ? (h.sum / h.count) : 0);
+}
+
+// Encode low 24 bits of counter (little endian)
+static void encode_counter(uint32_t counter, LoraEncoder &encoder)
+{
+    encoder.writeUint16(counter & 0xFFFF);
+    encoder.writeUint8((counter >> 16) & 0xFF);
+}
+
+void encode_stats(LoraEncoder &encoder)
+{
+    RuntimeStats s;
+
+    portENTER_CRITICAL(&statsMux);
+    s = rtStats;
+    portEXIT_CRITICAL(&statsMux);
+
+    encode_counter(s.wakeups, encoder);
+    encode_counter(s.mbRequests, encoder);
+    encode_counter(s.mbContinue, encoder);
+    encode_counter(s.mbErrors, encoder);
+    encode_counter(s.mbTimeouts, encoder);
+    encode_counter(s.mbCrcErrors, encoder);
+    encode_counter(s.mbRetries, encoder);
+    encode_counter(s.acqFailed, encoder);
+    encode_counter(s.uplinks, encoder);
+    encode_counter(s.uplinkBusy, encoder);
+    encode_counter(s.uplinkFailed, encoder);
+    encode_hist(s.acqTime, encoder);
+    encode_hist(s.wakeTime, encoder);
+}
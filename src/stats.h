@@ -0,0 +1,113 @@
+///////////////////////////////////////////////////////////////////////////////
+// stats.h
+//
+// Runtime statistics (kept in RTC RAM across deep sleep)
+//
+// Counters for Modbus requests/errors/retries, uplinks and skipped
+// uplinks as well as min/max/mean of acquisition and wake time.
+// The statistics are reported on request via downlink (CMD_GET_STATS).
+//
+// Counters are uint32 (no overflow within the lifetime of the device).
+// The response contains their low 24 bits to fit into 51 bytes (EU868
+// DR0..2), i.e. the reported values wrap around after 16777216 counts;
+// differences between two responses are computed modulo 2^24.
+// Counters are incremented from the acquisition task and from loop()
+// and are therefore protected by a critical section.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Counters changed to uint32, encoded as uint24 (wrap around)
+//          stats_inc()/stats_add() protected by critical section
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef STATS_H
+#define STATS_H
+
+#include "Arduino.h"
+#include <LoraMessage.h>
+
+/// Min/max/mean of a measured value
+struct StatHist {
+    uint16_t min;           //!< minimum
+    uint16_t max;           //!< maximum
+    uint16_t count;         //!< no. of samples
+    uint32_t sum;           //!< sum of samples
+};
+
+/// Runtime statistics
+struct RuntimeStats {
+    uint32_t wakeups;       //!< no. of wake-ups / restarts
+    uint32_t mbRequests;    //!< Modbus requests
+    uint32_t mbContinue;    //!< Modbus requests with more blocks pending
+    uint32_t mbErrors;      //!< Modbus requests failed
+    uint32_t mbTimeouts;    //!< Modbus requests timed out
+    uint32_t mbCrcErrors;   //!< Modbus responses with CRC error
+    uint32_t mbRetries;     //!< Modbus requests retried
+    uint32_t acqFailed;     //!< acquisitions failed after MODBUS_RETRIES
+    uint32_t uplinks;       //!< uplinks scheduled
+    uint32_t uplinkBusy;    //!< uplinks skipped (busy)
+    uint32_t uplinkFailed;  //!< uplinks failed
+    StatHist acqTime;       //!< acquisition time [ms]
+    StatHist wakeTime;      //!< time from wake-up until sleep [ms]
+};
+
+/// Runtime statistics in RTC RAM (reset at power-on)
+extern RuntimeStats rtStats;
+
+/// Size of encoded statistics in bytes
+#define STATS_SIZE  (11 * 3 + 2 * 6)
+
+/*!
+ * \brief Increment counter
+ *
+ * \param counter  counter
+ */
+void stats_inc(uint32_t &counter);
+
+/*!
+ * \brief Add sample to min/max/mean statistics
+ *
+ * \param h        statistics
+ * \param value    sample value
+ */
+void stats_add(StatHist &h, uint32_t value);
+
+/*!
+ * \brief Encode runtime statistics
+ *
+ * \param encoder  LoraEncoder object
+ */
+void encode_stats(LoraEncoder &encoder);
+
+#endif
@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////
+// timing.cpp
+//
+// Execution time measurement of acquisition and uplink stages
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Separate stage for each input register span of the read plan
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "timing.h"
+
+#if defined(ENABLE_TIMING)
+
+/// Accumulated statistics of one stage
+struct TimingStats {
+    uint32_t count;     //!< no. of measurements
+    uint32_t min;       //!< minimum duration [us]
+    uint32_t max;       //!< maximum duration [us]
+    uint64_t sum;       //!< sum of durations [us]
+};
+
+static TimingStats timingStats[TIMING_NUM_STAGES];
+
+// Stages are measured from the acquisition task and from loop()
+static portMUX_TYPE timingMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Get name of stage
+static void stageName(int stage, char *name, size_t size)
+{
+    static const char *names[] = {
+        "read holding",
+        "decode",
+        "acquisition",
+        "encode",
+        "send",
+        "tx done"
+    };
+    static_assert(sizeof(names) / sizeof(names[0]) == TIMING_NUM_STAGES - TIMING_READ_HOLDING,
+                  "stage names do not match TimingStage");
+
+    if (stage == TIMING_INIT) {
+        snprintf(name, size, "init");
+    } else if (stage <= TIMING_READ_LAST) {
+        snprintf(name, size, "read span %d", stage - TIMING_READ);
+    } else {
+        snprintf(name, size, "%s", names[stage - TIMING_READ_HOLDING]);
+    }
+}
+
+void timing_add(TimingStage stage, int64_t us)
+{
+    TimingStats &s = timingStats[stage];
+    uint32_t t = (us < 0) ? 0 : (uint32_t)us;
+
+    portENTER_CRITICAL(&timingMux);
+    if ((s.count == 0) || (t < s.min))
+        s.min = t;
+    if (t > s.max)
+        s.max = t;
+    s.sum += t;
+    s.count++;
+    portEXIT_CRITICAL(&timingMux);
+}
+
+void timing_report(void)
+{
+    TimingStats stats[TIMING_NUM_STAGES];
+
+    portENTER_CRITICAL(&timingMux);
+    memcpy(stats, timingStats, sizeof(stats));
+    memset(timingStats, 0, sizeof(timingStats));
+    portEXIT_CRITICAL(&timingMux);
+
+    log_i("%-12s %6s %10s %10s %10s", "stage [us]", "count", "min", "mean", "max");
+    for (int i = 0; i < TIMING_NUM_STAGES; i++) {
+        if (stats[i].count == 0)
+            continue;
+        char name[16];
+        stageName(i, name, sizeof(name));
+        log_i("%-12s %6u %10u %10u %10u", name, stats[i].count,
+              stats[i].min, (uint32_t)(stats[i].sum / stats[i].count), stats[i].max);
+    }
+}
+
+#endif
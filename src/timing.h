@@ -0,0 +1,112 @@
+///////////////////////////////////////////////////////////////////////////////
+// timing.h
+//
+// Execution time measurement of acquisition and uplink stages
+//
+// With ENABLE_TIMING defined in settings.h, the duration of each stage
+// (Modbus interface init, each planned input register span, holding
+// register read, decoding, payload encoding, SendBuffer hand-off, TX
+// completion and the complete acquisition cycle) is measured with
+// esp_timer_get_time() and accumulated. A summary table (count/min/mean/max)
+// is logged every TIMING_REPORT uplinks.
+//
+// The host benchmark (host/bench/) reports the same table for acquisitions
+// from the simulated inverter.
+//
+// Without ENABLE_TIMING, all macros expand to nothing.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Separate stage for each input register span of the read plan
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TIMING_H
+#define TIMING_H
+
+#include "Arduino.h"
+#include "settings.h"
+#include "growattRegisters.h"
+
+/// Measured stages
+enum TimingStage : uint8_t {
+    TIMING_INIT,        //!< Modbus interface initialization
+    TIMING_READ,        //!< Modbus input register read - first span of read plan
+    TIMING_READ_LAST = TIMING_READ + MAX_READ_SPANS - 1,    //!< last span of read plan
+    TIMING_READ_HOLDING,    //!< Modbus holding register read (all spans)
+    TIMING_DECODE,      //!< register decoding
+    TIMING_ACQ,         //!< complete acquisition cycle (incl. delays)
+    TIMING_ENCODE,      //!< payload encoding
+    TIMING_SEND,        //!< SendBuffer() hand-off
+    TIMING_TXDONE,      //!< SendBuffer() until TX completion
+    TIMING_NUM_STAGES
+};
+
+#if defined(ENABLE_TIMING)
+    #include "esp_timer.h"
+
+    /// Start measurement; var holds the start time [us]
+    #define TIMING_BEGIN(var)           int64_t var = esp_timer_get_time()
+
+    /// Start measurement with existing variable
+    #define TIMING_RESTART(var)         var = esp_timer_get_time()
+
+    /// Stage of input register read plan span no. n
+    #define TIMING_READ_SPAN(n)         static_cast<TimingStage>(TIMING_READ + (n))
+
+    /// Stop measurement and add duration to stage
+    #define TIMING_END(stage, var)      timing_add(stage, esp_timer_get_time() - (var))
+
+    /// Log summary table
+    #define TIMING_REPORT_TABLE()       timing_report()
+
+    /*!
+     * \brief Add measured duration to stage statistics
+     *
+     * \param stage    measured stage
+     * \param us       duration in microseconds
+     */
+    void timing_add(TimingStage stage, int64_t us);
+
+    /*!
+     * \brief Log summary table of all stages and reset statistics
+     */
+    void timing_report(void);
+#else
+    #define TIMING_BEGIN(var)
+    #define TIMING_RESTART(var)
+    #define TIMING_END(stage, var)
+    #define TIMING_REPORT_TABLE()
+#endif
+
+#endif
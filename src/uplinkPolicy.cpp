@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////////////////////////
+// uplinkPolicy.cpp
+//
+// Confirmed/unconfirmed uplink policy
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "uplinkPolicy.h"
+
+UplinkPolicy uplinkPolicy;
+
+/// Policy state - in RTC RAM to survive deep sleep
+struct PolicyState {
+    uint8_t frames;             //!< uplinks since last confirmed uplink
+    uint8_t ackHist;            //!< ACK history of last 8 confirmed uplinks (bit 0: latest)
+    uint8_t ackCount;           //!< no. of valid entries in ackHist
+    uint8_t good;               //!< consecutive ACKs with sufficient margin
+    bool    escalated;          //!< all uplinks confirmed
+};
+
+RTC_DATA_ATTR static PolicyState policyState;
+
+void UplinkPolicy::config(uint8_t confirmEvery, uint8_t ackRateMin, int8_t marginMin)
+{
+    m_confirmEvery = confirmEvery;
+    m_ackRateMin   = ackRateMin;
+    m_marginMin    = marginMin;
+}
+
+bool UplinkPolicy::confirmed(void)
+{
+    if (policyState.escalated || (m_confirmEvery == 1))
+        return true;
+    if (m_confirmEvery == 0)
+        return false;
+
+    // periodic link check
+    if (++policyState.frames >= m_confirmEvery) {
+        policyState.frames = 0;
+        return true;
+    }
+    return false;
+}
+
+uint8_t UplinkPolicy::ackRate(void)
+{
+    if (policyState.ackCount == 0)
+        return 100;
+
+    uint8_t acks = 0;
+    for (uint8_t i = 0; i < policyState.ackCount; i++) {
+        if (policyState.ackHist & (1 << i))
+            acks++;
+    }
+    return acks * 100 / policyState.ackCount;
+}
+
+void UplinkPolicy::result(bool acked, int8_t margin)
+{
+    policyState.ackHist = (policyState.ackHist << 1) | (acked ? 1 : 0);
+    if (policyState.ackCount < 8)
+        policyState.ackCount++;
+    policyState.frames = 0;
+
+    bool bad = (ackRate() < m_ackRateMin) || (acked && (margin < m_marginMin));
+
+    if (bad || !acked) {
+        policyState.good = 0;
+    } else if (policyState.good < UINT8_MAX) {
+        policyState.good++;
+    }
+
+    if (!policyState.escalated && bad) {
+        policyState.escalated = true;
+        log_i("Uplink policy: escalated (ACK rate %u%%, margin %d dB)", ackRate(), acked ? margin : 0);
+    } else if (policyState.escalated && !bad && (policyState.good >= POLICY_RECOVER)) {
+        policyState.escalated = false;
+        log_i("Uplink policy: link recovered (ACK rate %u%%)", ackRate());
+    }
+}
+
+bool UplinkPolicy::isEscalated(void)
+{
+    return policyState.escalated;
+}
@@ -0,0 +1,113 @@
+///////////////////////////////////////////////////////////////////////////////
+// uplinkPolicy.h
+//
+// Confirmed/unconfirmed uplink policy
+//
+// Periodic data is sent unconfirmed; every <confirmEvery>th uplink is sent
+// confirmed as a link check. If the ACK rate of the recent confirmed uplinks
+// or the link margin of the last ACK drops below its limit, all uplinks are
+// sent confirmed until the link has recovered (escalation).
+//
+// The policy is configured by downlink (CMD_SET_UPLINK_POLICY);
+// its state is kept in RTC RAM across deep sleep.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef UPLINK_POLICY_H
+#define UPLINK_POLICY_H
+
+#include "Arduino.h"
+#include "settings.h"
+
+/*!
+ * \class UplinkPolicy
+ *
+ * \brief Select confirmed/unconfirmed uplinks based on link quality
+ */
+class UplinkPolicy {
+public:
+    UplinkPolicy() {};
+
+    /*!
+     * \brief Set policy parameters
+     *
+     * \param confirmEvery   send every <n>th uplink confirmed (0: never, 1: always)
+     * \param ackRateMin     min. ACK rate of recent confirmed uplinks [%]
+     * \param marginMin      min. link margin of ACK [dB]
+     */
+    void config(uint8_t confirmEvery, uint8_t ackRateMin, int8_t marginMin);
+
+    /*!
+     * \brief Decide if the next uplink is sent confirmed
+     *
+     * Must be called once per scheduled uplink.
+     *
+     * \returns true if uplink shall be confirmed
+     */
+    bool confirmed(void);
+
+    /*!
+     * \brief Update link quality with result of confirmed uplink
+     *
+     * \param acked          ACK received
+     * \param margin         link margin of ACK [dB] (ignored if not acked)
+     */
+    void result(bool acked, int8_t margin);
+
+    /*!
+     * \brief Get escalation state
+     *
+     * \returns true if all uplinks are sent confirmed due to bad link quality
+     */
+    bool isEscalated(void);
+
+    /*!
+     * \brief Get ACK rate of recent confirmed uplinks
+     *
+     * \returns ACK rate [%]
+     */
+    uint8_t ackRate(void);
+
+private:
+    uint8_t m_confirmEvery = POLICY_CONFIRM_EVERY;  //!< confirmed uplink interval
+    uint8_t m_ackRateMin   = POLICY_ACK_RATE_MIN;   //!< min. ACK rate [%]
+    int8_t  m_marginMin    = POLICY_MARGIN_MIN;     //!< min. link margin [dB]
+};
+
+/// Uplink policy of data uplinks
+extern UplinkPolicy uplinkPolicy;
+
+#endif
@@ -0,0 +1,142 @@
+///////////////////////////////////////////////////////////////////////////////
+// uplinkScheduler.cpp
+//
+// Inverter state aware uplink scheduler
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Fault/warning bitmaps are reported by faultEvents
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "uplinkScheduler.h"
+#include "growattInterface.h"
+
+UplinkScheduler uplinkScheduler;
+
+/// Scheduler state - in RTC RAM to survive deep sleep
+struct SchedState {
+    InverterState state;        //!< inverter state
+    bool    night;              //!< local time is in night window
+    bool    valid;              //!< faultcode/deratingmode below are valid
+    int     faultcode;          //!< last faultcode
+    int     deratingmode;       //!< last deratingmode
+};
+
+RTC_DATA_ATTR static SchedState schedState;
+
+#if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_INFO
+static const char *stateName[] = {"unknown", "offline", "waiting", "producing", "derating", "fault"};
+#endif
+
+void UplinkScheduler::config(uint16_t idleInterval, uint16_t minPower, uint8_t nightStart, uint8_t nightEnd)
+{
+    m_idleInterval = idleInterval;
+    m_minPower     = minPower;
+    m_nightStart   = nightStart;
+    m_nightEnd     = nightEnd;
+}
+
+bool UplinkScheduler::update(const Snapshot &snap, int hour)
+{
+    InverterState state = schedState.state;
+
+    if (snap.result == growattIF::Success) {
+        const modbus_input_registers &d = snap.data;
+
+        if ((d.status == 3) || d.faultcode) {
+            state = INV_FAULT;
+        } else if ((d.status == 0) || (d.outputpower < m_minPower)) {
+            state = INV_WAITING;
+        } else if (d.deratingmode) {
+            state = INV_DERATING;
+        } else {
+            state = INV_PRODUCING;
+        }
+
+        // fault/derating transitions
+        // (fault/warning bitmaps are reported as events, see faultEvents.h)
+        if (schedState.valid &&
+            ((d.faultcode    != schedState.faultcode) ||
+             (d.deratingmode != schedState.deratingmode))) {
+            log_i("Scheduler: fault %d, derating %d", d.faultcode, d.deratingmode);
+            m_burst = true;
+        }
+        schedState.faultcode    = d.faultcode;
+        schedState.deratingmode = d.deratingmode;
+        schedState.valid        = true;
+    } else if (snap.result == ModbusTransport::ku8MBResponseTimedOut) {
+        state = INV_OFFLINE;
+    }
+
+    if (state != schedState.state) {
+        log_i("Scheduler: inverter %s -> %s", stateName[schedState.state], stateName[state]);
+        schedState.state = state;
+    }
+
+    // night window (wraps around midnight if start > end)
+    bool night = false;
+    if ((hour >= 0) && (m_nightStart != m_nightEnd)) {
+        night = (m_nightStart < m_nightEnd) ?
+            ((hour >= m_nightStart) && (hour < m_nightEnd)) :
+            ((hour >= m_nightStart) || (hour < m_nightEnd));
+    }
+    schedState.night = night;
+
+    // rate limited burst
+    if (m_burst && (!m_tBurst || (millis() - m_tBurst >= SCHED_BURST_HOLDOFF * 1000UL))) {
+        m_burst  = false;
+        m_tBurst = millis();
+        return true;
+    }
+    return false;
+}
+
+uint32_t UplinkScheduler::interval(uint32_t base)
+{
+    if (!isIdle())
+        return base;
+    return max(base, (uint32_t)m_idleInterval * 60);
+}
+
+InverterState UplinkScheduler::state(void)
+{
+    return schedState.state;
+}
+
+bool UplinkScheduler::isIdle(void)
+{
+    if ((m_idleInterval == 0) || (schedState.state == INV_FAULT))
+        return false;
+    return schedState.night || (schedState.state == INV_OFFLINE) || (schedState.state == INV_WAITING);
+}
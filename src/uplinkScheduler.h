@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////////
+// uplinkScheduler.h
+//
+// Inverter state aware uplink scheduler
+//
+// The inverter state is classified from the latest Modbus snapshot
+// (status, outputpower, faultcode, deratingmode) and the local time:
+//
+// - offline/waiting/no PV or night: uplink interval is stretched to
+//   <idleInterval> minutes
+// - production, derating or fault: normal uplink interval
+// - any change of faultcode or deratingmode requests an immediate uplink
+//   (burst; rate limited by SCHED_BURST_HOLDOFF); changes of faultbitcode
+//   and warningbitcode are sent as events (see faultEvents.h)
+//
+// The rules are configured by downlink (CMD_SET_SCHEDULE);
+// the state is kept in RTC RAM across deep sleep.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Fault/warning bitmaps are reported by faultEvents
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef UPLINK_SCHEDULER_H
+#define UPLINK_SCHEDULER_H
+
+#include "Arduino.h"
+#include "settings.h"
+#include "snapshot.h"
+
+/// Inverter state (as seen by the scheduler)
+enum InverterState : uint8_t {
+    INV_UNKNOWN,            // no data yet
+    INV_OFFLINE,            // inverter does not respond (no PV at night)
+    INV_WAITING,            // waiting or output power below threshold
+    INV_PRODUCING,          // normal operation
+    INV_DERATING,           // normal operation with derating
+    INV_FAULT               // fault
+};
+
+/*!
+ * \class UplinkScheduler
+ *
+ * \brief Select uplink interval based on inverter state and time of day
+ */
+class UplinkScheduler {
+public:
+    UplinkScheduler() {};
+
+    /*!
+     * \brief Set scheduler parameters
+     *
+     * If nightStart equals nightEnd, the night window is disabled.
+     *
+     * \param idleInterval   uplink interval while idle [min] (0: disabled)
+     * \param minPower       min. output power for production state [W]
+     * \param nightStart     start of night window [h, local time]
+     * \param nightEnd       end of night window [h, local time]
+     */
+    void config(uint16_t idleInterval, uint16_t minPower, uint8_t nightStart, uint8_t nightEnd);
+
+    /*!
+     * \brief Update inverter state from snapshot
+     *
+     * May be called repeatedly with the same snapshot.
+     *
+     * \param snap           Modbus snapshot
+     * \param hour           local hour of day (-1: unknown)
+     *
+     * \returns true if an immediate uplink is requested (burst)
+     */
+    bool update(const Snapshot &snap, int hour);
+
+    /*!
+     * \brief Get uplink interval
+     *
+     * \param base           normal uplink interval [s]
+     *
+     * \returns uplink interval [s]
+     */
+    uint32_t interval(uint32_t base);
+
+    /*!
+     * \brief Get inverter state
+     */
+    InverterState state(void);
+
+    /*!
+     * \brief Check if uplinks are stretched (offline, waiting or night)
+     */
+    bool isIdle(void);
+
+private:
+    uint16_t m_idleInterval = SCHED_IDLE_INTERVAL;  //!< uplink interval while idle [min]
+    uint16_t m_minPower     = SCHED_MIN_POWER;      //!< min. output power [W]
+    uint8_t  m_nightStart   = SCHED_NIGHT_START;    //!< start of night window [h]
+    uint8_t  m_nightEnd     = SCHED_NIGHT_END;      //!< end of night window [h]
+    uint32_t m_tBurst       = 0;                    //!< time of last burst [ms]
+    bool     m_burst        = false;                //!< burst suppressed by holdoff, still pending
+};
+
+/// Uplink scheduler of data uplinks
+extern UplinkScheduler uplinkScheduler;
+
+#endif